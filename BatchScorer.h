@@ -0,0 +1,340 @@
+#pragma once
+
+#include "CandidateSet.h"
+#include "Common.h"
+#include "FeedbackMatrix.h"
+#include "PartitionPolicy.h"
+
+#include <span>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MASTERMIND_HAS_AVX2_KERNEL 1
+#include <immintrin.h>
+#else
+#define MASTERMIND_HAS_AVX2_KERNEL 0
+#endif
+
+namespace Common
+{
+    //! LanePointers points to one color array per peg position, see BasicCandidateLanes
+    template <typename Config>
+    using LanePointers = std::array<const uint8_t*, Config::MaxLength>;
+
+    //! BasicCandidateLanes keeps candidate codes in structure of arrays layout
+    /*!
+        Instead of storing codes one after each other, colors of the first peg of all candidates are stored in one array,
+        colors of the second peg in another array and so on. This way a 256 bit register can load the same peg of 32 candidates at once.
+        Lanes are padded with zeros to a multiple of BlockSize so kernels never need to check the end of a block.
+    */
+    template <typename Config>
+    class BasicCandidateLanes
+    {
+    public:
+        static constexpr size_t BlockSize = 32;
+
+        BasicCandidateLanes() = default;
+
+        explicit BasicCandidateLanes( std::span<const BasicPackedCode<Config>> codes )
+        {
+            Assign(codes);
+        }
+
+        void Assign( std::span<const BasicPackedCode<Config>> codes )
+        {
+            size = codes.size();
+            size_t paddedSize = (size + BlockSize - 1) / BlockSize * BlockSize;
+            for ( int position = 0; position < Config::LengthOfSecret(); position++ )
+            {
+                lanes[position].assign(paddedSize, 0);
+                for ( size_t i = 0; i < size; i++ )
+                    lanes[position][i] = static_cast<uint8_t>(codes[i].GetPeg(position));
+            }
+        }
+
+        size_t Size() const
+        {
+            return size;
+        }
+
+        LanePointers<Config> Pointers() const
+        {
+            LanePointers<Config> returnVal;
+            for ( int position = 0; position < Config::LengthOfSecret(); position++ )
+                returnVal[position] = lanes[position].data();
+            return returnVal;
+        }
+
+    private:
+        size_t size = 0;
+        std::array<std::vector<uint8_t>, Config::MaxLength> lanes;
+    };
+
+    //! ScoreLanesScalar is the portable kernel which packs each candidate back and scores it with SWAR routines
+    template <typename Config>
+    void ScoreLanesScalar( BasicPackedCode<Config> guess, const std::type_identity_t<LanePointers<Config>>& lanes, size_t count, std::span<FeedbackId> out )
+    {
+        using Packed = BasicPackedCode<Config>;
+        // Local copy since out can alias anything and compiler would reload the pointers after every store
+        const LanePointers<Config> lanePointers = lanes;
+        for ( size_t i = 0; i < count; i++ )
+        {
+            Packed candidate;
+            for ( int position = 0; position < Config::LengthOfSecret(); position++ )
+                candidate.bits = static_cast<typename Packed::Word>((candidate.bits << Packed::BitsPerPeg) | lanePointers[position][i]);
+            out[i] = EncodeFeedback<Config>(BlackCount(guess, candidate), MatchCount(guess, candidate));
+        }
+    }
+
+#if MASTERMIND_HAS_AVX2_KERNEL
+    //! ScoreLanesAvx2 scores 32 candidates per instruction
+    /*!
+        Blacks are counted by comparing each peg lane with the guess's color for that position. Matches are the sum over colors
+        of min(candidate's count of the color, guess's count of the color), colors which are not in the guess are skipped.
+        Comparison results are 0xFF(-1) so subtracting them increments the counters.
+        FeedbackId is matches * (matches + 1) / 2 + blacks, the triangular number is looked up with a byte shuffle and
+        one is subtracted when all pegs are black.
+    */
+    template <typename Config>
+    __attribute__((target("avx2")))
+    void ScoreLanesAvx2( BasicPackedCode<Config> guess, const std::type_identity_t<LanePointers<Config>>& lanes, size_t count, std::span<FeedbackId> out )
+    {
+        auto guessHistogram = ColorHistogram(guess);
+        alignas(32) std::array<uint8_t, 32> triangularNumbers{};
+        for ( int matchCount = 0; matchCount <= Config::LengthOfSecret(); matchCount++ )
+        {
+            triangularNumbers[matchCount] = static_cast<uint8_t>(matchCount * (matchCount + 1) / 2);
+            triangularNumbers[matchCount + 16] = triangularNumbers[matchCount];
+        }
+        const auto triangularTable = _mm256_load_si256(reinterpret_cast<const __m256i*>(triangularNumbers.data()));
+        const auto allBlack = _mm256_set1_epi8(static_cast<char>(Config::LengthOfSecret()));
+
+        for ( size_t i = 0; i < count; i += 32 )
+        {
+            __m256i pegs[Config::MaxLength];
+            __m256i blacks = _mm256_setzero_si256();
+            for ( int position = 0; position < Config::LengthOfSecret(); position++ )
+            {
+                pegs[position] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes[position] + i));
+                auto guessColor = _mm256_set1_epi8(static_cast<char>(guess.GetPeg(position)));
+                blacks = _mm256_sub_epi8(blacks, _mm256_cmpeq_epi8(pegs[position], guessColor));
+            }
+
+            __m256i matches = _mm256_setzero_si256();
+            for ( int color = 1; color <= Config::ColorCount(); color++ )
+            {
+                if ( guessHistogram[color] == 0 )
+                    continue;
+                auto colorVector = _mm256_set1_epi8(static_cast<char>(color));
+                __m256i colorCount = _mm256_setzero_si256();
+                for ( int position = 0; position < Config::LengthOfSecret(); position++ )
+                    colorCount = _mm256_sub_epi8(colorCount, _mm256_cmpeq_epi8(pegs[position], colorVector));
+                matches = _mm256_add_epi8(matches, _mm256_min_epu8(colorCount, _mm256_set1_epi8(static_cast<char>(guessHistogram[color]))));
+            }
+
+            __m256i ids = _mm256_add_epi8(_mm256_shuffle_epi8(triangularTable, matches), blacks);
+            ids = _mm256_add_epi8(ids, _mm256_cmpeq_epi8(blacks, allBlack));
+
+            if ( i + 32 <= count )
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.data() + i), ids);
+            }
+            else
+            {
+                alignas(32) std::array<FeedbackId, 32> tail;
+                _mm256_store_si256(reinterpret_cast<__m256i*>(tail.data()), ids);
+                std::copy_n(tail.begin(), count - i, out.begin() + i);
+            }
+        }
+    }
+
+    inline bool HasAvx2()
+    {
+        static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+        return hasAvx2;
+    }
+#else
+    inline bool HasAvx2()
+    {
+        return false;
+    }
+#endif
+
+    //! ScoreLanes scores count candidates in lanes with the kernel selected at runtime, AVX2 when cpu supports it otherwise the scalar one
+    template <typename Config>
+    void ScoreLanes( BasicPackedCode<Config> guess, const std::type_identity_t<LanePointers<Config>>& lanes, size_t count, std::span<FeedbackId> out )
+    {
+#if MASTERMIND_HAS_AVX2_KERNEL
+        if ( HasAvx2() )
+        {
+            ScoreLanesAvx2(guess, lanes, count, out);
+            return;
+        }
+#endif
+        ScoreLanesScalar(guess, lanes, count, out);
+    }
+
+    //! ScoreAgainst writes the FeedbackId of guess against every candidate into out
+    /*!
+        Lanes must be padded to the BlockSize which BasicCandidateLanes already guarantees.
+    */
+    template <typename Config>
+    void ScoreAgainst( BasicPackedCode<Config> guess, const BasicCandidateLanes<Config>& candidates, std::span<FeedbackId> out )
+    {
+        ScoreLanes(guess, candidates.Pointers(), candidates.Size(), out);
+    }
+
+    //! ScoreAgainst for candidates which are not in lanes yet
+    /*!
+        Candidates are transposed into lanes block by block on stack, prefer keeping a BasicCandidateLanes when
+        same candidates are scored many times.
+    */
+    template <typename Config>
+    void ScoreAgainst( BasicPackedCode<Config> guess, std::span<const BasicPackedCode<Config>> candidates, std::span<FeedbackId> out )
+    {
+        constexpr size_t ChunkSize = 256;
+        alignas(32) std::array<std::array<uint8_t, ChunkSize>, Config::MaxLength> chunk;
+        for ( size_t start = 0; start < candidates.size(); start += ChunkSize )
+        {
+            size_t count = std::min(ChunkSize, candidates.size() - start);
+            LanePointers<Config> lanes;
+            for ( int position = 0; position < Config::LengthOfSecret(); position++ )
+            {
+                for ( size_t i = 0; i < count; i++ )
+                    chunk[position][i] = static_cast<uint8_t>(candidates[start + i].GetPeg(position));
+                std::fill(chunk[position].begin() + count, chunk[position].end(), 0);
+                lanes[position] = chunk[position].data();
+            }
+            ScoreLanes(guess, lanes, count, out.subspan(start, count));
+        }
+    }
+
+    using CandidateLanes = BasicCandidateLanes<ClassicConfig>;
+}
+
+//! CandidateScorer scores guesses against a fixed list of candidates
+/*!
+    Candidates are a list of codes or a CandidateSet, scores are written in the order of the list or in index order for a set.
+    It hides where the scores come from. When the code space is small enough for a FeedbackMatrix scores are read from the matrix,
+    otherwise candidates are kept in lanes and scored with the batch kernels. Elimination and the strategies which compare guesses
+    by their partitions use it.
+*/
+template <typename Config>
+class BasicCandidateScorer
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using FeedbackMatrix = BasicFeedbackMatrix<Config>;
+
+    //! PartitionScore is the result of ScorePartitions, scoredCount is how many candidates were scored before it returned
+    struct PartitionScore
+    {
+        uint64_t score;
+        size_t scoredCount;
+    };
+
+    explicit BasicCandidateScorer( const std::vector<Code>& candidates ) : candidateCount(candidates.size())
+    {
+        if ( FeedbackMatrix::IsAvailable() )
+        {
+            candidateIndexes.reserve(candidates.size());
+            for ( const auto& candidate : candidates )
+                candidateIndexes.push_back(candidate.GetIndex());
+        }
+        else
+        {
+            std::vector<Common::BasicPackedCode<Config>> packedCandidates;
+            packedCandidates.reserve(candidates.size());
+            for ( const auto& candidate : candidates )
+                packedCandidates.push_back(candidate.GetPacked());
+            lanes.Assign(packedCandidates);
+        }
+    }
+
+    explicit BasicCandidateScorer( const BasicCandidateSet<Config>& candidates ) : candidateCount(candidates.Count())
+    {
+        if ( FeedbackMatrix::IsAvailable() )
+        {
+            candidateIndexes.reserve(candidateCount);
+            candidates.ForEach([this]( size_t index ){
+                candidateIndexes.push_back(static_cast<int>(index));
+            });
+        }
+        else
+        {
+            std::vector<Common::BasicPackedCode<Config>> packedCandidates;
+            packedCandidates.reserve(candidateCount);
+            candidates.ForEach([&packedCandidates]( size_t index ){
+                packedCandidates.push_back(Common::BasicCodeSpace<Config>::Unrank(index));
+            });
+            lanes.Assign(packedCandidates);
+        }
+    }
+
+    //! Score writes feedback of guess against each candidate to out which should have Size() elements
+    void Score( const Code& guess, std::span<Common::FeedbackId> out ) const
+    {
+        if ( FeedbackMatrix::IsAvailable() )
+        {
+            const auto* guessRow = FeedbackMatrix::Instance().Row(guess.GetIndex());
+            for ( size_t i = 0; i < candidateIndexes.size(); i++ )
+                out[i] = guessRow[candidateIndexes[i]];
+        }
+        else
+        {
+            Common::ScoreAgainst(guess.GetPacked(), lanes, out);
+        }
+    }
+
+    //! ScorePartitions reduces the sizes of the partitions guess splits candidates into to a score with policy(see PartitionPolicy)
+    /*!
+        For a monotone policy scoring stops as soon as the score is bigger than bound, then returned score is bigger than bound but it
+        is only a lower bound of the real score. Batch kernels score ChunkSize candidates at a time into buffer which should have
+        at least min(Size(), ChunkSize) elements, so the bound is checked after every chunk.
+    */
+    template <typename Policy>
+    PartitionScore ScorePartitions( const Code& guess, const Policy& policy, uint64_t bound, std::span<Common::FeedbackId> buffer ) const
+    {
+        std::array<int, Common::MaxFeedbackCount<Config>> resultCounts{};
+        uint64_t score = policy.Initial();
+        if ( FeedbackMatrix::IsAvailable() )
+        {
+            const auto* guessRow = FeedbackMatrix::Instance().Row(guess.GetIndex());
+            for ( size_t i = 0; i < candidateIndexes.size(); i++ )
+            {
+                score = policy.Add(score, ++resultCounts[guessRow[candidateIndexes[i]]]);
+                if ( Policy::IsMonotone && score > bound )
+                    return PartitionScore{ score, i + 1 };
+            }
+            return PartitionScore{ score, candidateIndexes.size() };
+        }
+
+        auto lanePointers = lanes.Pointers();
+        for ( size_t start = 0; start < candidateCount; start += ChunkSize )
+        {
+            size_t count = std::min(ChunkSize, candidateCount - start);
+            Common::ScoreLanes(guess.GetPacked(), lanePointers, count, buffer.first(count));
+            for ( auto feedback : buffer.first(count) )
+                score = policy.Add(score, ++resultCounts[feedback]);
+            if ( Policy::IsMonotone && score > bound )
+                return PartitionScore{ score, start + count };
+            for ( int position = 0; position < Config::LengthOfSecret(); position++ )
+                lanePointers[position] += count;
+        }
+        return PartitionScore{ score, candidateCount };
+    }
+
+    size_t Size() const
+    {
+        return candidateCount;
+    }
+
+    static constexpr size_t ChunkSize = 8 * Common::BasicCandidateLanes<Config>::BlockSize;
+
+private:
+    size_t candidateCount;
+    std::vector<int> candidateIndexes;
+    Common::BasicCandidateLanes<Config> lanes;
+};
+
+using CandidateScorer = BasicCandidateScorer<Common::ClassicConfig>;
@@ -0,0 +1,620 @@
+#pragma once
+
+#include "../BatchScorer.h"
+#include "../CandidateSet.h"
+#include "../Common.h"
+#include "../DeadlineStrategy.h"
+#include "../Engines.h"
+#include "../GeneticStrategy.h"
+#include "../LookaheadStrategy.h"
+#include "../OpeningBook.h"
+#include "../OptimalStrategy.h"
+#include "../PortfolioStrategy.h"
+#include "../SampledStrategy.h"
+#include "../Strategy.h"
+#include "../ThreadPool.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+//! Benchmarks which are triggered by calling the binary with option "-b"
+/*!
+    Unit tests check the correctness, these functions print how fast the hot functions of the program are.
+    Each benchmark prints its name, how many calls it made and calls per second.
+*/
+namespace Benchmarks
+{
+    //! Measure runs the given function and prints the calls per second
+    /*!
+        Function should return the number of calls it made.
+    */
+    template <typename Function>
+    double Measure( const std::string& name, Function&& function )
+    {
+        auto start = std::chrono::steady_clock::now();
+        long long callCount = function();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double callsPerSecond = callCount / elapsed.count();
+        std::cout << name << ": " << callCount << " calls in " << elapsed.count() << " seconds, "
+                  << callsPerSecond << " calls/second" << std::endl;
+        return callsPerSecond;
+    }
+
+    std::vector<Common::Code> AllCodes()
+    {
+        auto allCodesView = Common::AllCodesView();
+        return std::vector<Common::Code>(allCodesView.begin(), allCodesView.end());
+    }
+
+    //! Compares every code against every other code with the reference sorting scoring, the histogram kernel and SWAR
+    void CompareBenchmark()
+    {
+        auto codes = AllCodes();
+        int checkSum = 0;
+        double before = Measure("Compare (reference sort + set_intersection)", [&codes, &checkSum]() {
+            long long callCount = 0;
+            for ( const auto& lhs : codes )
+                for ( const auto& rhs : codes )
+                {
+                    auto result = Common::ReferenceCompare<LengthOfSecret>(lhs.GetCode(), rhs.GetCode());
+                    checkSum += result.blackCount + result.whiteCount;
+                    callCount++;
+                }
+            return callCount;
+        });
+        double histogram = Measure("Compare (histogram kernel)", [&codes, &checkSum]() {
+            long long callCount = 0;
+            for ( const auto& lhs : codes )
+                for ( const auto& rhs : codes )
+                {
+                    auto result = Common::CompareCodes<LengthOfSecret, ColorCount>(lhs.GetCode(), rhs.GetCode());
+                    checkSum -= result.blackCount + result.whiteCount;
+                    callCount++;
+                }
+            return callCount;
+        });
+        double swar = Measure("Compare (SWAR on packed codes)", [&codes, &checkSum]() {
+            long long callCount = 0;
+            for ( const auto& lhs : codes )
+                for ( const auto& rhs : codes )
+                {
+                    auto result = lhs.Compare(rhs);
+                    checkSum += result.blackCount + result.whiteCount;
+                    callCount++;
+                }
+            return callCount;
+        });
+        std::cout << "Speedup of histogram kernel: " << histogram / before << "x, speedup of SWAR: " << swar / before
+                  << "x (checksum " << checkSum << ")" << std::endl;
+    }
+
+    //! Scores every code as a guess against all codes, one Compare at a time and with the batch kernels
+    void BatchScoringBenchmark()
+    {
+        auto codes = AllCodes();
+        std::vector<Common::PackedCode> packedCodes;
+        for ( const auto& code : codes )
+            packedCodes.push_back(code.GetPacked());
+        Common::CandidateLanes lanes(packedCodes);
+        std::vector<Common::FeedbackId> feedbacks(codes.size());
+        int checkSum = 0;
+
+        double before = Measure("Score against all (Compare per candidate)", [&]() {
+            long long callCount = 0;
+            for ( const auto& guess : codes )
+            {
+                for ( size_t i = 0; i < codes.size(); i++ )
+                    feedbacks[i] = guess.Compare(codes[i]).ToFeedbackId();
+                checkSum += feedbacks[guess.GetIndex()];
+                callCount += codes.size();
+            }
+            return callCount;
+        });
+        double scalar = Measure("Score against all (scalar lane kernel)", [&]() {
+            long long callCount = 0;
+            for ( const auto& guess : codes )
+            {
+                Common::ScoreLanesScalar(guess.GetPacked(), lanes.Pointers(), lanes.Size(), std::span(feedbacks));
+                checkSum -= feedbacks[guess.GetIndex()];
+                callCount += codes.size();
+            }
+            return callCount;
+        });
+        double dispatched = Measure(std::string("Score against all (dispatched kernel, ") + (Common::HasAvx2() ? "AVX2)" : "scalar)"), [&]() {
+            long long callCount = 0;
+            for ( const auto& guess : codes )
+            {
+                Common::ScoreAgainst(guess.GetPacked(), lanes, std::span(feedbacks));
+                checkSum += feedbacks[guess.GetIndex()];
+                callCount += codes.size();
+            }
+            return callCount;
+        });
+        std::cout << "Speedup of scalar lanes: " << scalar / before << "x, speedup of dispatched kernel: " << dispatched / before
+                  << "x (checksum " << checkSum << ")" << std::endl;
+    }
+
+    //! Eliminates all codes by every guess and secret pair, by scoring survivors into a new vector and by AND of partition masks
+    void EliminationBenchmark()
+    {
+        auto codes = AllCodes();
+        const auto& matrix = FeedbackMatrix::Instance();
+        const auto& masks = PartitionMasks::Instance();
+        size_t checkSum = 0;
+
+        double before = Measure("Eliminate (score survivors into a new vector)", [&]() {
+            long long callCount = 0;
+            CandidateScorer scorer(codes);
+            std::vector<Common::FeedbackId> feedbacks(codes.size());
+            for ( const auto& guess : codes )
+            {
+                scorer.Score(guess, feedbacks);
+                for ( size_t secretIndex = 0; secretIndex < codes.size(); secretIndex += 37 )
+                {
+                    std::vector<Common::Code> survivors;
+                    for ( size_t i = 0; i < codes.size(); i++ )
+                    {
+                        if ( feedbacks[i] == feedbacks[secretIndex] )
+                            survivors.push_back(codes[i]);
+                    }
+                    checkSum += survivors.size();
+                    callCount++;
+                }
+            }
+            return callCount;
+        });
+        double after = Measure("Eliminate (AND with partition mask)", [&]() {
+            long long callCount = 0;
+            for ( const auto& guess : codes )
+            {
+                for ( size_t secretIndex = 0; secretIndex < codes.size(); secretIndex += 37 )
+                {
+                    auto survivors = CandidateSet::All();
+                    survivors.IntersectWith(masks.Mask(guess.GetIndex(), matrix.Get(guess.GetIndex(), secretIndex)));
+                    checkSum -= survivors.Count();
+                    callCount++;
+                }
+            }
+            return callCount;
+        });
+        std::cout << "Speedup of partition masks: " << after / before << "x (checksum " << checkSum << ")" << std::endl;
+    }
+
+    //! Times MiniMax's second guess with one thread and with the configured thread count
+    /*!
+        Position is after 1122 got no black and no white, 256 codes are left and all 1296 codes are scored against them.
+    */
+    void MiniMaxThreadingBenchmark()
+    {
+        constexpr int GuessCount = 20;
+        auto codes = AllCodes();
+        auto probableCodes = CandidateSet::All();
+        probableCodes.IntersectWith(PartitionMasks::Instance().Mask(Common::Code(1122).GetIndex(), Common::Result{}.ToFeedbackId()));
+        GuessContext context;
+        context.Start(codes);
+        context.SetSymmetryReduction(false);
+        context.AddGuess(Common::Code(1122));
+        context.AddFeedback(Common::Result{}.ToFeedbackId(), probableCodes);
+
+        const int threadCount = ThreadPool::Instance().GetThreadCount();
+        auto measureGuesses = [&]( int currentThreadCount ) {
+            ThreadPool::SetThreadCount(currentThreadCount);
+            MiniMaxStrategy strategy;
+            strategy.SetTranspositionTable(nullptr);
+            strategy.SetIncremental(false);
+            return Measure("MiniMax second guess (" + std::to_string(currentThreadCount) + " threads)", [&]() {
+                for ( int i = 0; i < GuessCount; i++ )
+                    strategy.Guess(context);
+                return GuessCount;
+            });
+        };
+        double before = measureGuesses(1);
+        double after = measureGuesses(threadCount);
+        std::cout << "Speedup of " << threadCount << " threads: " << after / before << "x" << std::endl;
+    }
+
+    //! Plays MiniMax against every 7th secret exhaustively, with branch and bound and with incremental partition counts
+    /*!
+        Prints work done per move, for incremental counts a guess-candidate evaluation is one update of a partition count.
+    */
+    void MiniMaxPruningBenchmark()
+    {
+        auto codes = AllCodes();
+        const std::array<std::string, 3> names{ "exhaustive", "branch and bound", "incremental" };
+        for ( int variant = 0; variant < 3; variant++ )
+        {
+            auto strategy = std::make_shared<MiniMaxStrategy>(variant == 1);
+            strategy->SetTranspositionTable(nullptr);
+            strategy->SetIncremental(variant == 2);
+            Measure("MiniMax games (" + names[variant] + ")", [&]() {
+                int gameCount = 0;
+                for ( size_t secretIndex = 0; secretIndex < codes.size(); secretIndex += 7, gameCount++ )
+                {
+                    CodeBreaker codeBreaker( strategy );
+                    codeBreaker.SetAllCodes(codes);
+                    for ( int i = 0; i < MaximumRoundCount; i++ )
+                    {
+                        auto feedback = codeBreaker.Guess().Compare(codes[secretIndex]).ToFeedbackId();
+                        if ( feedback == Common::WinningFeedback )
+                            break;
+                        codeBreaker.SetResult(feedback);
+                    }
+                }
+                return gameCount;
+            });
+            const auto& statistics = strategy->GetStatistics();
+            std::cout << "Per move: " << statistics.evaluatedGuessCount / static_cast<double>(statistics.moveCount) << " guesses, "
+                      << statistics.scoredCandidateCount / static_cast<double>(statistics.moveCount) << " guess-candidate evaluations" << std::endl;
+        }
+    }
+
+    //! Times first three MiniMax guesses of a 5 pegs 8 colors game with and without symmetry reduction of the guess pool
+    void SymmetryBenchmark()
+    {
+        using Config = Engines::Config5x8;
+        auto allCodesView = Common::AllCodesView<Config>();
+        std::vector<Common::BasicCode<Config>> codes(allCodesView.begin(), allCodesView.end());
+        Common::BasicCode<Config> secret( {3,1,4,5,6} );
+        std::vector<double> callsPerSecond;
+        for ( bool isSymmetryReducing : { false, true } )
+        {
+            callsPerSecond.push_back(Measure(std::string("MiniMax 3 guesses of 5x8 (") + (isSymmetryReducing ? "symmetry reduced)" : "all guesses)"), [&]() {
+                auto strategy = std::make_shared<BasicMiniMaxStrategy<Config>>();
+                strategy->SetTranspositionTable(nullptr);
+                BasicCodeBreaker<Config> codeBreaker( strategy );
+                codeBreaker.SetAllCodes(codes);
+                codeBreaker.SetSymmetryReduction(isSymmetryReducing);
+                for ( int i = 0; i < 3; i++ )
+                    codeBreaker.SetResult(codeBreaker.Guess().Compare(secret).template ToFeedbackId<Config>());
+                return 1;
+            }));
+        }
+        std::cout << "Speedup of symmetry reduction: " << callsPerSecond[1] / callsPerSecond[0] << "x" << std::endl;
+    }
+
+    //! Builds the MiniMax opening book and plays every secret with live MiniMax and with the book
+    void OpeningBookBenchmark()
+    {
+        auto codes = AllCodes();
+        std::shared_ptr<const OpeningBook> book;
+        Measure("Build MiniMax opening book", [&]() {
+            book = OpeningBook::Build(std::make_shared<MiniMaxStrategy>(), Common::GameMode::MiniMax);
+            return 1;
+        });
+        std::cout << "Opening book has " << book->NodeCount() << " guesses" << std::endl;
+
+        auto playAll = [&codes]( std::shared_ptr<IStrategy> strategy ) {
+            for ( const auto& secret : codes )
+            {
+                CodeBreaker codeBreaker( strategy );
+                codeBreaker.SetAllCodes(codes);
+                for ( int i = 0; i < MaximumRoundCount; i++ )
+                {
+                    auto feedback = codeBreaker.Guess().Compare(secret).ToFeedbackId();
+                    if ( feedback == Common::WinningFeedback )
+                        break;
+                    codeBreaker.SetResult(feedback);
+                }
+            }
+            return static_cast<long long>(codes.size());
+        };
+        double before = Measure("MiniMax games (live)", [&]() {
+            auto strategy = std::make_shared<MiniMaxStrategy>();
+            strategy->SetTranspositionTable(nullptr);
+            return playAll(strategy);
+        });
+        double after = Measure("MiniMax games (opening book)", [&]() {
+            return playAll(std::make_shared<BookStrategy>(book, std::make_shared<MiniMaxStrategy>()));
+        });
+        std::cout << "Speedup of opening book: " << after / before << "x" << std::endl;
+
+        auto& transpositionTable = TranspositionTable::Instance();
+        transpositionTable.Clear();
+        double cached = Measure("MiniMax games (transposition table)", [&]() {
+            return playAll(std::make_shared<MiniMaxStrategy>());
+        });
+        std::cout << "Speedup of transposition table: " << cached / before << "x, " << transpositionTable.GetHitCount() << " hits "
+                  << transpositionTable.GetMissCount() << " misses" << std::endl;
+    }
+
+    //! Plays Swaszek games with every specialized engine and with the generic engine
+    /*!
+        Generic engine is measured with the classic size too, so the cost of not unrolling loops over pegs and colors can be seen.
+    */
+    void EngineBenchmark()
+    {
+        constexpr int GameCount = 20;
+        std::vector<Engine> engines(Engines::SpecializedEngines.begin(), Engines::SpecializedEngines.end());
+        Common::RuntimeConfig::Set(LengthOfSecret, ColorCount);
+        engines.push_back(Engines::MakeEngine<Common::RuntimeConfig>(false));
+        for ( const auto& engine : engines )
+        {
+            int totalWinTurnCount = 0;
+            std::string name = "Swaszek games (" + std::to_string(engine.lengthOfSecret) + " pegs " + std::to_string(engine.colorCount) +
+                               " colors, " + (engine.isSpecialized ? "specialized" : "generic") + " engine)";
+            // First game builds the feedback matrix of the configuration, it is not measured
+            engine.playGame(Common::GameMode::Swaszek, false, std::chrono::milliseconds::zero());
+            Measure(name, [&engine, &totalWinTurnCount]() {
+                for ( int i = 0; i < GameCount; i++ )
+                    totalWinTurnCount += engine.playGame(Common::GameMode::Swaszek, false, std::chrono::milliseconds::zero()) + 1;
+                return GameCount;
+            });
+            std::cout << "Average win round: " << totalWinTurnCount / static_cast<double>(GameCount) << std::endl;
+        }
+    }
+
+    //! Plays every secret with each computer strategy and prints games per second with average and maximum number of guesses
+    void StrategyBenchmark()
+    {
+        auto codes = AllCodes();
+        auto miniMaxStrategy = std::make_shared<MiniMaxStrategy>();
+        miniMaxStrategy->SetTranspositionTable(nullptr);
+        const std::vector<std::pair<std::string, std::shared_ptr<IStrategy>>> strategies{
+            { "MiniMax", miniMaxStrategy },
+            { "Entropy", std::make_shared<EntropyStrategy>() },
+            { "ExpectedSize", std::make_shared<ExpectedSizeStrategy>() },
+            { "MostParts", std::make_shared<MostPartsStrategy>() },
+            { "Swaszek", std::make_shared<SwaszekStrategy>() } };
+        for ( const auto& [name, strategy] : strategies )
+        {
+            int totalWinTurnCount = 0;
+            int maximumWinTurnCount = 0;
+            Measure(name + " games (every secret)", [&]() {
+                for ( const auto& secret : codes )
+                {
+                    CodeBreaker codeBreaker( strategy );
+                    codeBreaker.SetAllCodes(codes);
+                    for ( int i = 0; i < MaximumRoundCount; i++ )
+                    {
+                        auto feedback = codeBreaker.Guess().Compare(secret).ToFeedbackId();
+                        if ( feedback == Common::WinningFeedback )
+                        {
+                            totalWinTurnCount += i + 1;
+                            maximumWinTurnCount = std::max(maximumWinTurnCount, i + 1);
+                            break;
+                        }
+                        codeBreaker.SetResult(feedback);
+                    }
+                }
+                return static_cast<long long>(codes.size());
+            });
+            std::cout << "Average win round: " << totalWinTurnCount / static_cast<double>(codes.size()) << ", at most "
+                      << maximumWinTurnCount << std::endl;
+        }
+    }
+
+    //! Searches the optimal strategy of a 4 pegs 4 colors game and prints nodes per second
+    void OptimalSearchBenchmark()
+    {
+        using Config = Common::GameConfig<4, 4>;
+        TranspositionTable table;
+        BasicOptimalStrategy<Config> strategy;
+        strategy.SetTranspositionTable(&table);
+        uint32_t cost = 0;
+        double searchesPerSecond = Measure("Optimal search of 4x4", [&]() {
+            cost = strategy.Cost(BasicCandidateSet<Config>::All(), {});
+            return 1;
+        });
+        std::cout << "Average win round: " << cost / static_cast<double>(Common::GetCodeCount<Config>()) << ", "
+                  << strategy.GetStatistics().nodeCount << " nodes, " << strategy.GetStatistics().nodeCount * searchesPerSecond
+                  << " nodes/second" << std::endl;
+    }
+
+    //! Plays random secrets of 8 pegs 12 colors with the genetic strategy and prints evaluations per second and eligible codes
+    void GeneticBenchmark()
+    {
+        using Config = Common::GameConfig<8, 12>;
+        using Code = Common::BasicCode<Config>;
+        constexpr int GameCount = 20;
+        auto strategy = std::make_shared<BasicGeneticStrategy<Config>>();
+        std::mt19937 random(2024);
+        std::uniform_int_distribution<int> colorDistribution(1, Config::ColorCount());
+        int totalWinTurnCount = 0;
+        int wonCount = 0;
+        size_t totalEligibleCount = 0;
+        Measure("Genetic games of 8x12", [&]() {
+            for ( int game = 0; game < GameCount; game++ )
+            {
+                typename Code::CodeArray colorCodeList{};
+                for ( int i = 0; i < Config::LengthOfSecret(); i++ )
+                    colorCodeList[i] = colorDistribution(random);
+                const Code secret(colorCodeList);
+                BasicCodeBreaker<Config> codeBreaker( strategy );
+                codeBreaker.StartWithoutEnumeration();
+                for ( int i = 0; i < Config::MaximumRoundCount(); i++ )
+                {
+                    auto feedback = codeBreaker.Guess().Compare(secret).template ToFeedbackId<Config>();
+                    if ( i > 0 )
+                        totalEligibleCount += strategy->GetStatistics().eligibleCount;
+                    codeBreaker.SetResult(feedback);
+                    if ( feedback == Common::GetWinningFeedback<Config>() )
+                    {
+                        totalWinTurnCount += i + 1;
+                        wonCount++;
+                        break;
+                    }
+                }
+            }
+            return GameCount;
+        });
+        const auto statistics = strategy->GetStatistics();
+        std::cout << "Average win round: " << totalWinTurnCount / static_cast<double>(wonCount) << ", won " << wonCount << " of "
+                  << GameCount << ", " << totalEligibleCount / static_cast<double>(statistics.searchCount) << " eligible codes per guess, "
+                  << statistics.EvaluationsPerSecond() << " evaluations/second" << std::endl;
+    }
+
+    //! Plays the same secrets of 5 pegs 8 colors with sampled MiniMax at growing time budgets, prints guess quality against time per move
+    void SampledMiniMaxBenchmark()
+    {
+        using Config = Common::GameConfig<5, 8>;
+        using Code = Common::BasicCode<Config>;
+        constexpr size_t SecretStep = 1637;
+        auto allCodesView = Common::AllCodesView<Config>();
+        const std::vector<Code> codes(allCodesView.begin(), allCodesView.end());
+        std::cout << "Sampled MiniMax of 5x8, time budget | seconds per move | guesses scored per move | average win round" << std::endl;
+        for ( int milliseconds : { 1, 4, 16, 64 } )
+        {
+            typename BasicSampledMiniMaxStrategy<Config>::Settings settings;
+            settings.timeBudget = std::chrono::milliseconds(milliseconds);
+            auto strategy = std::make_shared<BasicSampledMiniMaxStrategy<Config>>(settings);
+            int totalWinTurnCount = 0;
+            int gameCount = 0;
+            for ( size_t secretIndex = 0; secretIndex < codes.size(); secretIndex += SecretStep, gameCount++ )
+            {
+                BasicCodeBreaker<Config> codeBreaker( strategy );
+                codeBreaker.SetAllCodes(codes);
+                for ( int i = 0; i < Config::MaximumRoundCount(); i++ )
+                {
+                    auto feedback = codeBreaker.Guess().Compare(codes[secretIndex]).template ToFeedbackId<Config>();
+                    codeBreaker.SetResult(feedback);
+                    if ( feedback == Common::GetWinningFeedback<Config>() )
+                    {
+                        totalWinTurnCount += i + 1;
+                        break;
+                    }
+                }
+            }
+            const auto statistics = strategy->GetStatistics();
+            std::cout << milliseconds << " ms | " << statistics.seconds / statistics.moveCount << " | "
+                      << statistics.scoredGuessCount / static_cast<double>(statistics.moveCount) << " | "
+                      << totalWinTurnCount / static_cast<double>(gameCount) << std::endl;
+        }
+    }
+
+    //! DeadlineBenchmark plays exact MiniMax of 5x8 with a deadline for every move, without the TranspositionTable
+    void DeadlineBenchmark()
+    {
+        using Config = Common::GameConfig<5, 8>;
+        using Code = Common::BasicCode<Config>;
+        constexpr size_t SecretStep = 1637;
+        auto allCodesView = Common::AllCodesView<Config>();
+        const std::vector<Code> codes(allCodesView.begin(), allCodesView.end());
+        std::cout << "MiniMax of 5x8 with deadline, move budget | moves cut | seconds per move | slowest move | average win round" << std::endl;
+        for ( int milliseconds : { 1, 4, 16, 64 } )
+        {
+            auto miniMaxStrategy = std::make_shared<BasicMiniMaxStrategy<Config>>();
+            miniMaxStrategy->SetTranspositionTable(nullptr);
+            auto strategy = std::make_shared<BasicDeadlineStrategy<Config>>(miniMaxStrategy, std::chrono::milliseconds(milliseconds));
+            int totalWinTurnCount = 0;
+            int gameCount = 0;
+            for ( size_t secretIndex = 0; secretIndex < codes.size(); secretIndex += SecretStep, gameCount++ )
+            {
+                BasicCodeBreaker<Config> codeBreaker( strategy );
+                codeBreaker.SetAllCodes(codes);
+                for ( int i = 0; i < Config::MaximumRoundCount(); i++ )
+                {
+                    auto feedback = codeBreaker.Guess().Compare(codes[secretIndex]).template ToFeedbackId<Config>();
+                    codeBreaker.SetResult(feedback);
+                    if ( feedback == Common::GetWinningFeedback<Config>() )
+                    {
+                        totalWinTurnCount += i + 1;
+                        break;
+                    }
+                }
+            }
+            const auto statistics = strategy->GetStatistics();
+            std::cout << milliseconds << " ms | " << statistics.CutRate() * 100 << "% | " << statistics.seconds / statistics.moveCount << " | "
+                      << statistics.maximumSeconds << " | " << totalWinTurnCount / static_cast<double>(gameCount) << std::endl;
+        }
+    }
+
+    //! PortfolioBenchmark races the default members on 5x8 with a budget for every move and counts the rounds each member won
+    void PortfolioBenchmark()
+    {
+        using Config = Common::GameConfig<5, 8>;
+        using Code = Common::BasicCode<Config>;
+        constexpr size_t SecretStep = 1637;
+        auto allCodesView = Common::AllCodesView<Config>();
+        const std::vector<Code> codes(allCodesView.begin(), allCodesView.end());
+        std::cout << "Portfolio of 5x8, move budget | seconds per move | average win round | rounds won by each member" << std::endl;
+        for ( int milliseconds : { 4, 16, 64 } )
+        {
+            auto strategy = std::make_shared<BasicPortfolioStrategy<Config>>(BasicPortfolioStrategy<Config>::DefaultMembers(),
+                                                                             std::chrono::milliseconds(milliseconds));
+            int totalWinTurnCount = 0;
+            int gameCount = 0;
+            auto start = std::chrono::steady_clock::now();
+            for ( size_t secretIndex = 0; secretIndex < codes.size(); secretIndex += SecretStep, gameCount++ )
+            {
+                BasicCodeBreaker<Config> codeBreaker( strategy );
+                codeBreaker.SetAllCodes(codes);
+                for ( int i = 0; i < Config::MaximumRoundCount(); i++ )
+                {
+                    auto feedback = codeBreaker.Guess().Compare(codes[secretIndex]).template ToFeedbackId<Config>();
+                    codeBreaker.SetResult(feedback);
+                    if ( feedback == Common::GetWinningFeedback<Config>() )
+                    {
+                        totalWinTurnCount += i + 1;
+                        break;
+                    }
+                }
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            std::cout << milliseconds << " ms | " << elapsed.count() / totalWinTurnCount << " | "
+                      << totalWinTurnCount / static_cast<double>(gameCount) << " |";
+            for ( size_t i = 0; i < strategy->GetMembers().size(); i++ )
+                std::cout << " " << strategy->GetMembers()[i].name << " " << strategy->GetStatistics().winCounts[i];
+            std::cout << std::endl;
+        }
+    }
+
+    //! LookaheadBenchmark plays all secrets of the classic game with widths and depths of LookaheadStrategy, time against guesses
+    void LookaheadBenchmark()
+    {
+        auto allCodesView = Common::AllCodesView();
+        const std::vector<Common::Code> codes(allCodesView.begin(), allCodesView.end());
+        std::cout << "Lookahead of 4x6, width x depth | seconds | nodes | average win round | maximum win round" << std::endl;
+        for ( auto [width, depth] : { std::pair(1, 1), std::pair(10, 1), std::pair(5, 2), std::pair(10, 2), std::pair(20, 2), std::pair(5, 3) } )
+        {
+            LookaheadStrategy::Settings settings;
+            settings.width = width;
+            settings.depth = depth;
+            auto strategy = std::make_shared<LookaheadStrategy>(settings);
+            int totalWinTurnCount = 0;
+            int maximumWinTurnCount = 0;
+            auto start = std::chrono::steady_clock::now();
+            for ( const auto& secret : codes )
+            {
+                CodeBreaker codeBreaker( strategy );
+                codeBreaker.SetAllCodes(codes);
+                for ( int i = 0; i < MaximumRoundCount; i++ )
+                {
+                    auto feedback = codeBreaker.Guess().Compare(secret).ToFeedbackId();
+                    codeBreaker.SetResult(feedback);
+                    if ( feedback == Common::WinningFeedback )
+                    {
+                        totalWinTurnCount += i + 1;
+                        maximumWinTurnCount = std::max(maximumWinTurnCount, i + 1);
+                        break;
+                    }
+                }
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            std::cout << width << " x " << depth << " | " << elapsed.count() << " | " << strategy->GetStatistics().nodeCount << " | "
+                      << totalWinTurnCount / static_cast<double>(codes.size()) << " | " << maximumWinTurnCount << std::endl;
+        }
+    }
+
+    void RunAll()
+    {
+        CompareBenchmark();
+        BatchScoringBenchmark();
+        EliminationBenchmark();
+        MiniMaxThreadingBenchmark();
+        MiniMaxPruningBenchmark();
+        SymmetryBenchmark();
+        OpeningBookBenchmark();
+        StrategyBenchmark();
+        OptimalSearchBenchmark();
+        SampledMiniMaxBenchmark();
+        DeadlineBenchmark();
+        PortfolioBenchmark();
+        LookaheadBenchmark();
+        GeneticBenchmark();
+        EngineBenchmark();
+    }
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "Common.h"
+#include "FeedbackMatrix.h"
+
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+//! CandidateSet is a set of codes stored as a bitset over code indexes
+/*!
+    Bit i is set when the code with index i(Code::GetIndex) is in the set. For the classic game the whole set is 1296 bits
+    which is 21 words, so copying a set, intersecting two sets or counting its elements(popcount) are a few dozen instructions.
+    Elements are visited in index order by scanning set bits, which is the same order as allCodes.
+*/
+template <typename Config>
+class BasicCandidateSet
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using Word = uint64_t;
+    static constexpr size_t BitsPerWord = 64;
+
+    static size_t WordCount()
+    {
+        return static_cast<size_t>((Common::BasicCodeSpace<Config>::Size() + BitsPerWord - 1) / BitsPerWord);
+    }
+
+    BasicCandidateSet() : words(WordCount(), 0)
+    {
+    }
+
+    explicit BasicCandidateSet( const std::vector<Code>& codes ) : BasicCandidateSet()
+    {
+        for ( const auto& code : codes )
+            Insert(code.GetIndex());
+    }
+
+    //! Placeholder returns an empty set without storage
+    /*!
+        Count, Empty and ForEach work on it, other members should only be used after a sized set is assigned to it. Games whose
+        codes are not enumerated use it so that they do not allocate WordCount words, which is 54 MB for 8 pegs and 12 colors.
+    */
+    static BasicCandidateSet Placeholder()
+    {
+        return BasicCandidateSet(std::vector<Word>{});
+    }
+
+    //! All returns the set of all codes
+    static BasicCandidateSet All()
+    {
+        BasicCandidateSet returnVal;
+        size_t codeCount = Common::BasicCodeSpace<Config>::Size();
+        std::fill(returnVal.words.begin(), returnVal.words.end(), ~Word{0});
+        if ( codeCount % BitsPerWord != 0 )
+            returnVal.words.back() = (Word{1} << (codeCount % BitsPerWord)) - 1;
+        return returnVal;
+    }
+
+    void Insert( size_t index )
+    {
+        words[index / BitsPerWord] |= Word{1} << (index % BitsPerWord);
+    }
+
+    void Erase( size_t index )
+    {
+        words[index / BitsPerWord] &= ~(Word{1} << (index % BitsPerWord));
+    }
+
+    bool Contains( size_t index ) const
+    {
+        return (words[index / BitsPerWord] >> (index % BitsPerWord)) & 1;
+    }
+
+    size_t Count() const
+    {
+        size_t returnVal = 0;
+        for ( auto word : words )
+            returnVal += std::popcount(word);
+        return returnVal;
+    }
+
+    bool Empty() const
+    {
+        return std::all_of(words.begin(), words.end(), []( Word word ){
+            return word == 0;
+        });
+    }
+
+    //! First returns the smallest index in the set, set should not be empty
+    size_t First() const
+    {
+        for ( size_t i = 0; i < words.size(); i++ )
+        {
+            if ( words[i] != 0 )
+                return i * BitsPerWord + std::countr_zero(words[i]);
+        }
+        return Common::BasicCodeSpace<Config>::Size();
+    }
+
+    //! ForEach calls function with index of every code in the set in increasing order
+    template <typename Function>
+    void ForEach( Function&& function ) const
+    {
+        for ( size_t i = 0; i < words.size(); i++ )
+        {
+            for ( Word word = words[i]; word != 0; word &= word - 1 )
+                function(i * BitsPerWord + std::countr_zero(word));
+        }
+    }
+
+    std::vector<Code> ToCodes() const
+    {
+        std::vector<Code> returnVal;
+        returnVal.reserve(Count());
+        ForEach([&returnVal]( size_t index ){
+            returnVal.push_back(Code::FromIndex(index));
+        });
+        return returnVal;
+    }
+
+    //! IntersectWith keeps only the codes whose bits are also set in mask, mask should have WordCount words
+    void IntersectWith( std::span<const Word> mask )
+    {
+        for ( size_t i = 0; i < words.size(); i++ )
+            words[i] &= mask[i];
+    }
+
+    BasicCandidateSet& operator&=( const BasicCandidateSet& rhs )
+    {
+        IntersectWith(rhs.words);
+        return *this;
+    }
+
+    BasicCandidateSet& operator|=( const BasicCandidateSet& rhs )
+    {
+        for ( size_t i = 0; i < words.size(); i++ )
+            words[i] |= rhs.words[i];
+        return *this;
+    }
+
+    //! Subtract removes the codes of rhs from the set
+    BasicCandidateSet& Subtract( const BasicCandidateSet& rhs )
+    {
+        for ( size_t i = 0; i < words.size(); i++ )
+            words[i] &= ~rhs.words[i];
+        return *this;
+    }
+
+    bool operator==( const BasicCandidateSet& rhs ) const = default;
+
+    std::span<const Word> Words() const
+    {
+        return words;
+    }
+
+private:
+    explicit BasicCandidateSet( std::vector<Word> words ) : words(std::move(words))
+    {
+    }
+
+    std::vector<Word> words;
+};
+
+//! PartitionMasks holds for every guess and feedback the set of codes which would give that feedback
+/*!
+    After guess g gets feedback f the codes which can still be the secret are the previous ones intersected with
+    Mask(g, f), so elimination is a single AND of two bitsets. Masks of a guess are built from its FeedbackMatrix row
+    the first time the guess is asked for, a row of the classic game is 14 masks of 21 words. It is thread safe.
+    Like the FeedbackMatrix it only exists for configurations with a FeedbackMatrix.
+*/
+template <typename Config>
+class BasicPartitionMasks
+{
+public:
+    using CandidateSet = BasicCandidateSet<Config>;
+    using Word = typename CandidateSet::Word;
+    using FeedbackMatrix = BasicFeedbackMatrix<Config>;
+
+    static constexpr bool IsAvailable()
+    {
+        return FeedbackMatrix::IsAvailable();
+    }
+
+    static const BasicPartitionMasks& Instance()
+    {
+        static const BasicPartitionMasks masks;
+        return masks;
+    }
+
+    std::span<const Word> Mask( int guessIndex, Common::FeedbackId feedback ) const
+    {
+        std::call_once(rowFlags[guessIndex], [this, guessIndex](){
+            BuildRow(guessIndex);
+        });
+        const size_t wordCount = CandidateSet::WordCount();
+        return std::span<const Word>(rows[guessIndex].data() + feedback * wordCount, wordCount);
+    }
+
+private:
+    BasicPartitionMasks() : rowFlags(IsAvailable() ? Common::GetCodeCount<Config>() : 0), rows(rowFlags.size())
+    {
+    }
+
+    void BuildRow( int guessIndex ) const
+    {
+        const size_t wordCount = CandidateSet::WordCount();
+        const auto* feedbacks = FeedbackMatrix::Instance().Row(guessIndex);
+        auto& row = rows[guessIndex];
+        row.assign(Common::GetFeedbackCount<Config>() * wordCount, 0);
+        for ( int candidateIndex = 0; candidateIndex < FeedbackMatrix::Instance().GetCodeCount(); candidateIndex++ )
+            row[feedbacks[candidateIndex] * wordCount + candidateIndex / CandidateSet::BitsPerWord] |= Word{1} << (candidateIndex % CandidateSet::BitsPerWord);
+    }
+
+    mutable std::vector<std::once_flag> rowFlags;
+    mutable std::vector<std::vector<Word>> rows;
+};
+
+using CandidateSet = BasicCandidateSet<Common::ClassicConfig>;
+using PartitionMasks = BasicPartitionMasks<Common::ClassicConfig>;
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Common.h"
+#include "BatchScorer.h"
+#include "CandidateSet.h"
+#include "GuessContext.h"
 #include "Strategy.h"
 
 #include <memory>
@@ -10,59 +13,141 @@
     CodeBreaker is creating guesses. It encapsulates a strategy which can differ itself depending on user command options.
     But independently from strategy there are some algorithms it runs like eliminating codes from possible code list
     if they do not return the same result as its last guess. To be able to feed the strategy it holds a track of
-    it guesses, eliminated list of codes and all codes.
+    it guesses, eliminated list of codes and all codes in a GuessContext which it passes to the strategy.
+    Codes which can still be the secret are kept as a CandidateSet. When partition masks exist for the configuration
+    elimination is an AND with the mask of the last guess and its feedback, otherwise survivors are scored with the batch kernels.
+    Strategies which search for a guess search the guess pool of the context, only one code from each class of codes which are
+    symmetric given past guesses. A game started with StartWithoutEnumeration keeps only the history, it does not eliminate codes.
 */
-class CodeBreaker
+template <typename Config>
+class BasicCodeBreaker
 {
 public:
-    CodeBreaker() = default;
+    using Code = Common::BasicCode<Config>;
+    using Strategy = BasicIStrategy<Config>;
+    using GuessContext = BasicGuessContext<Config>;
+    using CandidateSet = BasicCandidateSet<Config>;
+    using PartitionMasks = BasicPartitionMasks<Config>;
 
-    CodeBreaker( std::shared_ptr<IStrategy> strategy ) : strategy(strategy)
+    BasicCodeBreaker() = default;
+
+    BasicCodeBreaker( std::shared_ptr<Strategy> strategy ) : strategy(strategy)
     {
     }
 
-    void SetStrategy( std::shared_ptr<IStrategy> strategy )
+    void SetStrategy( std::shared_ptr<Strategy> strategy )
     {
         this->strategy = strategy;
+        isStrategyStarted = false;
     }
-    void SetAllCodes( const std::vector<Common::Code>& allCodes )
+
+    //! SetAllCodes starts a new game in which every code of allCodes can be the secret
+    void SetAllCodes( const std::vector<Code>& allCodes )
     {
-        this->allCodes = allCodes;
-        probableCodes = allCodes;
+        context.Start(allCodes);
+        isStrategyStarted = false;
     }
 
-    Common::Code Guess()
+    //! StartWithoutEnumeration starts a new game in which every code can be the secret without listing the codes
+    /*!
+        It is for code spaces which are too big to enumerate, strategy should generate its guesses from the history(GeneticStrategy).
+    */
+    void StartWithoutEnumeration()
     {
-        auto returnVal = strategy->Guess(allCodes, probableCodes, pastGuesses);
-        pastGuesses.push_back(returnVal);
+        context.StartWithoutEnumeration();
+        isStrategyStarted = false;
+    }
+
+    const CandidateSet& GetProbableCodes() const
+    {
+        return context.Candidates();
+    }
+
+    const GuessContext& GetContext() const
+    {
+        return context;
+    }
+
+    //! SetSymmetryReduction turns reducing the guess pool by symmetry on or off, it is on by default
+    void SetSymmetryReduction( bool isSymmetryReducing )
+    {
+        context.SetSymmetryReduction(isSymmetryReducing);
+    }
+
+    Code Guess()
+    {
+        if ( !isStrategyStarted )
+        {
+            strategy->OnGameStart(context);
+            isStrategyStarted = true;
+        }
+        auto returnVal = strategy->Guess(context);
+        context.AddGuess(returnVal);
         return returnVal;
     }
 
     int SetResult(const Common::Result& currentResult)
     {
-        pastResults.push_back(currentResult);
-        return Eliminate(currentResult);
+        return SetResult(currentResult.ToFeedbackId<Config>());
+    }
+
+    //! SetResult records the feedback of the last guess and returns the number of codes which can still be the secret
+    /*!
+        Returns -1 when the game is not enumerated since the number is not known then.
+    */
+    int SetResult(Common::FeedbackId currentFeedback)
+    {
+        if ( !context.IsEnumerated() )
+        {
+            context.AddFeedback(currentFeedback);
+            Notify(currentFeedback, CandidateSet::Placeholder());
+            return -1;
+        }
+
+        CandidateSet probableCodes = context.Candidates();
+        Eliminate(probableCodes, currentFeedback);
+        CandidateSet eliminatedCodes = context.Candidates();
+        eliminatedCodes.Subtract(probableCodes);
+        context.AddFeedback(currentFeedback, probableCodes);
+        Notify(currentFeedback, eliminatedCodes);
+        return probableCodes.Count();
     }
 
 private:
+    void Notify( Common::FeedbackId currentFeedback, const CandidateSet& eliminatedCodes )
+    {
+        if ( !strategy )
+            return;
+        strategy->OnFeedback(context, eliminatedCodes);
+        bool isWon = currentFeedback == Common::GetWinningFeedback<Config>();
+        if ( isWon || static_cast<int>(context.PastGuesses().size()) >= Config::MaximumRoundCount() )
+            strategy->OnGameEnd(context, isWon);
+    }
 
-    int Eliminate( const Common::Result& currentResult )
+    void Eliminate( CandidateSet& probableCodes, Common::FeedbackId currentFeedback ) const
     {
-        const auto& curGuess = pastGuesses.back();
-        std::vector<Common::Code> tempCodes = std::move(probableCodes);
-        std::ranges::copy_if( tempCodes, std::back_inserter(probableCodes), [currentResult, curGuess]( const Common::Code& candidateCode ){
-            auto tempResult = candidateCode.Compare(curGuess);
-            return tempResult == currentResult;
-        });
+        const auto& lastGuess = context.PastGuesses().back();
+        if ( PartitionMasks::IsAvailable() )
+        {
+            probableCodes.IntersectWith(PartitionMasks::Instance().Mask(lastGuess.GetIndex(), currentFeedback));
+            return;
+        }
 
-        return probableCodes.size();
-    }
+        auto feedbacks = context.FeedbackScratch(probableCodes.Count());
+        BasicCandidateScorer<Config>(probableCodes).Score(lastGuess, feedbacks);
 
+        const CandidateSet tempCodes = probableCodes;
+        size_t i = 0;
+        tempCodes.ForEach([&probableCodes, &feedbacks, &i, currentFeedback]( size_t index ){
+            if ( feedbacks[i++] != currentFeedback )
+                probableCodes.Erase(index);
+        });
+    }
 
-    std::vector<Common::Code> allCodes;
-    std::shared_ptr<IStrategy> strategy;
-    std::vector<Common::Code> probableCodes;
-    std::vector<Common::Code> pastGuesses;
-    std::vector<Common::Result> pastResults;
+    std::shared_ptr<Strategy> strategy;
+    GuessContext context;
+    bool isStrategyStarted = false;
 };
 
+using CodeBreaker = BasicCodeBreaker<Common::ClassicConfig>;
+
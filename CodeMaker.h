@@ -7,18 +7,23 @@
     Code maker encapsulates the all important secretCode. SecretCode is random each time which takes advantage of CTOR of CommonCode.
     And it compares its secret code by given guess.
 */
-class CodeMaker
+template <typename Config>
+class BasicCodeMaker
 {
 public:
-    Common::Result GetResultOfGuess( Common::Code guessCode )
+    using Code = Common::BasicCode<Config>;
+
+    Common::Result GetResultOfGuess( Code guessCode )
     {
         return secretCode.Compare(guessCode);
     }
 
-    const Common::Code& GetSecretCode() const
+    const Code& GetSecretCode() const
     {
         return secretCode;
     }
 private:
-    Common::Code secretCode;
-};
\ No newline at end of file
+    Code secretCode;
+};
+
+using CodeMaker = BasicCodeMaker<Common::ClassicConfig>;
\ No newline at end of file
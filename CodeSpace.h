@@ -0,0 +1,72 @@
+#pragma once
+
+#include "PackedCode.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+
+namespace Common
+{
+    //! BasicCodeSpace is the set of all possible codes of a game
+    /*!
+        Codes are numbered in mixed radix where every peg is a digit in base Colors and first peg is the most significant digit.
+        That is the same order NextCode iterates, 1111 has rank 0 and 6666 has rank 1295 for the classic game.
+        Rank and Unrank are O(pegs) so a code and its index can be converted to each other without any table,
+        View provides a random access range over the whole space which creates codes on demand instead of holding them in memory.
+        This is the foundation for spaces which are too large to be stored.
+    */
+    template <typename Config>
+    class BasicCodeSpace
+    {
+    public:
+        using Index = uint64_t;
+        using PackedCode = BasicPackedCode<Config>;
+
+        static constexpr Index Size()
+        {
+            Index returnVal = 1;
+            for ( int i = 0; i < Config::LengthOfSecret(); i++ )
+                returnVal *= Config::ColorCount();
+            return returnVal;
+        }
+
+        static constexpr Index Rank( PackedCode code )
+        {
+            Index returnVal = 0;
+            for ( int position = 0; position < Config::LengthOfSecret(); position++ )
+                returnVal = returnVal * Config::ColorCount() + (code.GetPeg(position) - 1);
+            return returnVal;
+        }
+
+        static constexpr PackedCode Unrank( Index index )
+        {
+            PackedCode returnVal;
+            for ( int position = Config::LengthOfSecret() - 1; position >= 0; position-- )
+            {
+                auto peg = static_cast<typename PackedCode::Word>(index % Config::ColorCount() + 1);
+                returnVal.bits |= static_cast<typename PackedCode::Word>(peg << ((Config::LengthOfSecret() - 1 - position) * PackedCode::BitsPerPeg));
+                index /= Config::ColorCount();
+            }
+            return returnVal;
+        }
+
+        //! View is a random access, sized view over all codes in rank order
+        /*!
+            It iterates 32 bit ranks, iota of 64 bit integers has a 128 bit difference type and its iterators are not
+            iterators of the standard library in strict ISO mode, so containers could not be constructed from them. Spaces
+            with more codes can not be enumerated anyway, View stops after 2^32 - 1 codes.
+        */
+        static auto View()
+        {
+            const auto viewSize = static_cast<ViewIndex>(std::min<Index>(Size(), std::numeric_limits<ViewIndex>::max()));
+            return std::views::iota(ViewIndex{0}, viewSize) | std::views::transform([]( ViewIndex index ){
+                return Unrank(index);
+            });
+        }
+
+    private:
+        using ViewIndex = uint32_t;
+    };
+}
@@ -1,33 +1,97 @@
 #pragma once
 
+#include "CodeSpace.h"
+#include "GameConfig.h"
+#include "PackedCode.h"
+
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <random>
 #include <ranges>
 #include <span>
+#include <string>
+#include <vector>
 
-constexpr int LengthOfSecret = 4;
-constexpr int ColorCount     = 6;
-constexpr int MaximumRoundCount = 10;
+constexpr int LengthOfSecret = Common::ClassicConfig::LengthOfSecret();
+constexpr int ColorCount     = Common::ClassicConfig::ColorCount();
+constexpr int MaximumRoundCount = Common::ClassicConfig::MaximumRoundCount();
 
 namespace Common
 {
+    //! FeedbackId compact one byte representation of a Result
+    /*!
+        Tables which store many results (FeedbackMatrix for example) use this instead of Result to keep memory small.
+        Ids are dense, every valid (black, white) pair maps to a number in [0, FeedbackCount) so ids can directly index
+        fixed size arrays. Pairs are ordered by matches(black + white) first and blacks second:
+        id = matches * (matches + 1) / 2 + blacks. Only invalid pair is (Length - 1) blacks with 1 white, it is skipped which
+        makes the winning feedback the last id. For 4 pegs there are 14 ids.
+    */
+    using FeedbackId = uint8_t;
+
+    template <typename Config>
+    constexpr int GetFeedbackCount()
+    {
+        return (Config::LengthOfSecret() + 1) * (Config::LengthOfSecret() + 2) / 2 - 1;
+    }
+
+    //! MaxFeedbackCount is the capacity to use for arrays indexed by FeedbackId
+    template <typename Config>
+    constexpr int MaxFeedbackCount = (Config::MaxLength + 1) * (Config::MaxLength + 2) / 2 - 1;
+
+    template <typename Config>
+    constexpr FeedbackId GetWinningFeedback()
+    {
+        return static_cast<FeedbackId>(GetFeedbackCount<Config>() - 1);
+    }
+
+    template <typename Config>
+    constexpr FeedbackId EncodeFeedback( int blackCount, int matchCount )
+    {
+        return static_cast<FeedbackId>(matchCount * (matchCount + 1) / 2 + blackCount - (blackCount == Config::LengthOfSecret() ? 1 : 0));
+    }
+
+    constexpr int FeedbackCount = GetFeedbackCount<ClassicConfig>();
+    constexpr FeedbackId WinningFeedback = GetWinningFeedback<ClassicConfig>();
+
+    //! Mix64 is the finalizer of splitmix64, every bit of x changes about half of the bits of the result
+    constexpr uint64_t Mix64( uint64_t x )
+    {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
     //! GameMode
     /*!
-        Game currently has three modes. It can be played as a Human. In this case user will give it guesses by stdin.
-        Or there are two algorithms which will be using by computer.
+        Game currently has ten modes. It can be played as a Human. In this case user will give it guesses by stdin.
+        Or there are nine algorithms which will be using by computer.
+        Count is not a mode, it is the number of modes so tables indexed by mode grow when a mode is added before it.
     */
     enum class GameMode
     {
         Human = 0,
         MiniMax,
-        Swaszek
+        Swaszek,
+        Entropy,
+        ExpectedSize,
+        MostParts,
+        Optimal,
+        Genetic,
+        Portfolio,
+        Lookahead,
+        Count
     };
 
+    constexpr size_t GameModeCount = static_cast<size_t>(GameMode::Count);
+
     //! Result
     /*!
         According to wikipedia there are two outcomes after an guess.
         If both position and color is right than codekeeper should add a black peg.
         If only position is correct than only a white peg should be added.
+        Conversions to and from FeedbackId depend on the length of the secret so they take the configuration.
     */
     struct Result
     {
@@ -39,13 +103,89 @@ namespace Common
             return rhs.blackCount == blackCount && rhs.whiteCount == whiteCount ;
         }
 
-        std::string ToString()
+        std::string ToString() const
         {
             return std::to_string(blackCount) + " black " + std::to_string(whiteCount) + " white";
         }
+
+        template <typename Config = ClassicConfig>
+        FeedbackId ToFeedbackId() const
+        {
+            return EncodeFeedback<Config>(blackCount, blackCount + whiteCount);
+        }
+
+        template <typename Config = ClassicConfig>
+        static Result FromFeedbackId( FeedbackId id )
+        {
+            for ( int matchCount = 0; matchCount <= Config::LengthOfSecret(); matchCount++ )
+            {
+                int blackCount = id - matchCount * (matchCount + 1) / 2 + (id == GetWinningFeedback<Config>() ? 1 : 0);
+                if ( blackCount >= 0 && blackCount <= matchCount )
+                    return Result{ blackCount, matchCount - blackCount };
+            }
+            return Result{};
+        }
     };
 
-    //! Code Encapsulates the all important code
+    //! CompareCodes scoring kernel for codes in array form
+    /*!
+        Blacks are the positions which are equal. Whites are calculated by summing the minimum count of each color in both codes
+        and subtracting blacks from it. Color histograms are fixed size arrays on stack so there is no sorting and no allocation.
+        Since it is templated on length and color count compiler can unroll all loops.
+        Colors should be in range [1, Colors].
+    */
+    template <int Length, int Colors>
+    Result CompareCodes( const std::array<int,Length>& lhs, const std::array<int,Length>& rhs )
+    {
+        Result returnVal;
+        std::array<int,Colors+1> lhsHistogram{};
+        std::array<int,Colors+1> rhsHistogram{};
+        for ( int i = 0; i < Length; i++ )
+        {
+            returnVal.blackCount += lhs[i] == rhs[i];
+            lhsHistogram[lhs[i]]++;
+            rhsHistogram[rhs[i]]++;
+        }
+
+        int matchCount = 0;
+        for ( int color = 1; color <= Colors; color++ )
+            matchCount += std::min(lhsHistogram[color], rhsHistogram[color]);
+
+        returnVal.whiteCount = matchCount - returnVal.blackCount;
+        return returnVal;
+    }
+
+    //! ReferenceCompare is the original sorting based scoring
+    /*!
+        It is kept only as a reference to test CompareCodes against and for measuring it in benchmarks.
+    */
+    template <int Length>
+    Result ReferenceCompare( const std::array<int,Length>& lhs, const std::array<int,Length>& rhs )
+    {
+        Result returnVal;
+        for ( size_t i = 0; i < Length; i++ )
+        {
+            if ( rhs[i] == lhs[i] )
+            {
+                returnVal.blackCount++;
+            }
+        }
+
+        auto sortedSelfCopy = lhs;
+        auto sortedCompareCopy = rhs;
+
+        std::ranges::sort(sortedSelfCopy);
+        std::ranges::sort(sortedCompareCopy);
+
+        std::vector<int> intersectionSet;
+        std::set_intersection(sortedSelfCopy.begin(), sortedSelfCopy.end(),
+                              sortedCompareCopy.begin(), sortedCompareCopy.end(), std::back_inserter(intersectionSet));
+
+        returnVal.whiteCount = intersectionSet.size() - returnVal.blackCount;
+        return returnVal;
+    }
+
+    //! BasicCode Encapsulates the all important code
     /*!
         This class encapsulate all important code. It is often some actions are repeated in this game by different entities like CodeBreaker,
         CodeKeeper. That is why those functions are encapsulate in this all accessible struct.
@@ -53,85 +193,98 @@ namespace Common
         1 - Compare function which return a result after comparing codes
         2 - This struct provides functions to iterate to next code example 1112-->1113.Please see unit tests for more.
         3 - Convenient CTORs which accepts array, integer or generates a random code when nothing provided.
+        Internally pegs are stored as a PackedCode which is 8 times smaller than an array of ints, array and integer
+        forms are only a conversion layer.
+        It is a template on game configuration, Common::Code is the code of the classic game.
     */
-    struct Code
+    template <typename Config>
+    struct BasicCode
     {
-        Code()
+        using PackedCode = BasicPackedCode<Config>;
+        using CodeSpace = BasicCodeSpace<Config>;
+        using CodeArray = std::array<int,Config::MaxLength>;
+
+        BasicCode()
         {
             GenerateRandomCode();
         }
 
-        Code( std::array<int,LengthOfSecret> colorCodeList )
+        BasicCode( CodeArray colorCodeList ) : code(PackedCode::FromArray(colorCodeList))
+        {
+        }
+
+        BasicCode( PackedCode packedCode ) : code(packedCode)
         {
-            code = colorCodeList;
         }
 
-        Code( int integerCode )
+        BasicCode( int integerCode )
         {
-            for ( int i = 0; i < LengthOfSecret; i++ )
+            CodeArray colorCodeList{};
+            for ( int i = Config::LengthOfSecret() - 1; i >= 0; i-- )
             {
-                int moduler = pow(10, i+1);
-                int divider = moduler/10;
-                int currentDigit = integerCode % moduler / divider;
-                code[i] = currentDigit;
+                colorCodeList[i] = integerCode % 10;
+                integerCode /= 10;
             }
-            std::reverse(code.begin(), code.end());
+            code = PackedCode::FromArray(colorCodeList);
         }
 
-        bool operator==( const Code& rhs ) const
+        bool operator==( const BasicCode& rhs ) const
         {
             return rhs.code == code;
         }
 
-        Result Compare( const Code& rhs ) const
+        //! Index of the code within all possible codes
+        /*!
+            Codes are ordered as they are generated by NextCode, 1111 has index 0 and 6666 has index 1295.
+            Tables like FeedbackMatrix are indexed by this value.
+        */
+        int GetIndex() const
         {
-            Result returnVal;
-            const auto& compareCode = rhs.GetCode();
-            for ( size_t i = 0; i < LengthOfSecret; i++ )
-            {
-                int compareNumber = compareCode[i];
-                if ( compareNumber == code[i] )
-                {
-                    returnVal.blackCount++;
-                }
-            }
-
-            auto sortedSelfCopy = code;
-            auto sortedCompareCopy = compareCode;
+            return static_cast<int>(CodeSpace::Rank(code));
+        }
 
-            std::ranges::sort(sortedSelfCopy);
-            std::ranges::sort(sortedCompareCopy);
+        static BasicCode FromIndex( typename CodeSpace::Index index )
+        {
+            return BasicCode(CodeSpace::Unrank(index));
+        }
 
-            std::vector<int> intersectionSet;
-            std::set_intersection(sortedSelfCopy.begin(), sortedSelfCopy.end(),
-                                  sortedCompareCopy.begin(), sortedCompareCopy.end(), std::back_inserter(intersectionSet));
+        Result Compare( const BasicCode& rhs ) const
+        {
+            int blackCount = BlackCount(code, rhs.code);
+            return Result{ blackCount, MatchCount(code, rhs.code) - blackCount };
+        }
 
-            returnVal.whiteCount = intersectionSet.size() - returnVal.blackCount;
-            return returnVal;
+        bool IsValid() const
+        {
+            auto colorCodeList = GetCode();
+            return std::all_of(colorCodeList.begin(), colorCodeList.begin() + Config::LengthOfSecret(), []( int elem ){
+                return elem >= 1 && elem <= Config::ColorCount();
+            });
         }
 
-        std::array<int,LengthOfSecret> NextCode() const
+        CodeArray NextCode() const
         {
-            std::array<int,LengthOfSecret> returnVal = code;
-            if ( code.back() != ColorCount)
+            CodeArray returnVal = GetCode();
+            const int lastIndex = Config::LengthOfSecret() - 1;
+            if ( returnVal[lastIndex] != Config::ColorCount())
             {
-                returnVal[LengthOfSecret-1] += 1;
+                returnVal[lastIndex] += 1;
                 return returnVal;
             }
 
-            bool isLastElem = std::all_of(code.begin(), code.end(), []( int elem ){
-                return elem == ColorCount;
+            bool isLastElem = std::all_of(returnVal.begin(), returnVal.begin() + Config::LengthOfSecret(), []( int elem ){
+                return elem == Config::ColorCount();
             });
             if ( isLastElem )
                 return returnVal;
 
-            IncreaseCodeIndex(returnVal, LengthOfSecret-1);
+            IncreaseCodeIndex(returnVal, lastIndex);
             return returnVal;
         }
 
-        void IncreaseCodeIndex( std::array<int,LengthOfSecret>& code, int index ) const
+        void IncreaseCodeIndex( CodeArray& code, int index ) const
         {
-            if( code[index] == ColorCount )
+            if( code[index] == Config::ColorCount() )
             {
                 code[index] = 1;
                 IncreaseCodeIndex(code, index-1);
@@ -143,14 +296,19 @@ namespace Common
         std::string ToString() const
         {
             std::string out;
-            for ( auto elem : code )
+            for ( int i = 0; i < Config::LengthOfSecret(); i++ )
             {
-                out.append("*" + std::to_string(elem) + "*");
+                out.append("*" + std::to_string(code.GetPeg(i)) + "*");
             }
             return out;
         }
 
-        const std::array<int,LengthOfSecret>& GetCode() const
+        CodeArray GetCode() const
+        {
+            return code.ToArray();
+        }
+
+        PackedCode GetPacked() const
         {
             return code;
         }
@@ -160,25 +318,53 @@ namespace Common
         {
             std::random_device rd;
             std::mt19937 gen(rd());
-            std::uniform_int_distribution<> distrib(1, ColorCount);
-            for ( size_t i = 0; i < LengthOfSecret; i++ )
+            std::uniform_int_distribution<> distrib(1, Config::ColorCount());
+            CodeArray colorCodeList{};
+            for ( int i = 0; i < Config::LengthOfSecret(); i++ )
             {
-                code[i] = distrib(gen);
+                colorCodeList[i] = distrib(gen);
             }
+            code = PackedCode::FromArray(colorCodeList);
         }
 
-        std::array<int,LengthOfSecret> code;
+        PackedCode code;
     };
 
+    using PackedCode = BasicPackedCode<ClassicConfig>;
+    using CodeSpace = BasicCodeSpace<ClassicConfig>;
+    using Code = BasicCode<ClassicConfig>;
+
     //! GetStartingInteger
     /*!
         The user input starts from 1111 or 11111 or something like 1111.. depending on the length of secret.
         This function calculates this number.
     */
+    template <typename Config = ClassicConfig>
     int GetStartingInteger() {
         int returnVal = 0;
-        for ( int i = 0; i < LengthOfSecret; i++ )
-            returnVal += pow(10, i);
+        for ( int i = 0; i < Config::LengthOfSecret(); i++ )
+            returnVal = returnVal * 10 + 1;
         return returnVal;
     }
+
+    //! GetCodeCount
+    /*!
+        Number of all possible codes which is ColorCount ^ LengthOfSecret, 1296 for the classic game.
+    */
+    template <typename Config = ClassicConfig>
+    constexpr int GetCodeCount() {
+        return static_cast<int>(BasicCodeSpace<Config>::Size());
+    }
+
+    //! AllCodesView random access view over all codes in index order
+    /*!
+        Codes are created on demand while iterating, nothing is materialized. Element i is Code::FromIndex(i).
+    */
+    template <typename Config = ClassicConfig>
+    auto AllCodesView()
+    {
+        return BasicCodeSpace<Config>::View() | std::views::transform([]( BasicPackedCode<Config> packedCode ){
+            return BasicCode<Config>(packedCode);
+        });
+    }
 }
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Common.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <vector>
+
+//! ConsistentCodeFinder finds a code which can still be the secret from the history alone, without enumerating the codes
+/*!
+    A code is consistent when every past guess would get its past feedback if the code was the secret. Finder is a backtracking
+    search which assigns pegs left to right and stops a branch as soon as one past feedback can not be met any more:
+    1 - Domains of the pegs are reduced before the search. A feedback without blacks removes the color of the guess at every
+        position from that position, a feedback without any match removes all colors of the guess from every position.
+    2 - For each past guess the blacks and the matches(blacks + whites) of the assigned pegs are kept. Matches of the pegs are
+        the sum over colors of min(count in pegs, count in guess), so they only grow while pegs are added and by at most one per peg.
+        A branch stops when blacks or matches are more than the feedback has, when matches can not reach the feedback with the
+        pegs left, or when blacks can not reach it with the positions left whose domain has the color of the guess.
+    First returns the consistent code with the smallest index, which is the first candidate of the enumerated game. Random tries
+    colors of every peg in a random order, it returns some consistent code but not uniformly distributed ones.
+    Work is proportional to the nodes of the search instead of the size of the code space, so games of 10 or more pegs which can
+    not be stored can be played.
+*/
+template <typename Config>
+class BasicConsistentCodeFinder
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using CodeArray = typename Code::CodeArray;
+
+    BasicConsistentCodeFinder( const std::vector<Code>& pastGuesses, const std::vector<Common::FeedbackId>& pastFeedbacks )
+    {
+        const uint32_t allColors = ((uint32_t{1} << Config::ColorCount()) - 1) << 1;
+        domains.fill(allColors);
+        for ( size_t i = 0; i < pastFeedbacks.size(); i++ )
+        {
+            Constraint constraint;
+            constraint.pegs = pastGuesses[i].GetCode();
+            auto result = Common::Result::FromFeedbackId<Config>(pastFeedbacks[i]);
+            constraint.blackCount = result.blackCount;
+            constraint.matchCount = result.blackCount + result.whiteCount;
+            for ( int position = 0; position < Config::LengthOfSecret(); position++ )
+            {
+                const int color = constraint.pegs[position];
+                constraint.colorCounts[color]++;
+                if ( constraint.blackCount == 0 )
+                    domains[position] &= ~(uint32_t{1} << color);
+            }
+            if ( constraint.matchCount == 0 )
+            {
+                for ( int position = 0; position < Config::LengthOfSecret(); position++ )
+                {
+                    for ( int color = 1; color <= Config::ColorCount(); color++ )
+                    {
+                        if ( constraint.colorCounts[color] > 0 )
+                            domains[position] &= ~(uint32_t{1} << color);
+                    }
+                }
+            }
+            constraints.push_back(constraint);
+        }
+        for ( auto& constraint : constraints )
+        {
+            for ( int position = Config::LengthOfSecret() - 1; position >= 0; position-- )
+            {
+                const bool canBeBlack = (domains[position] >> constraint.pegs[position]) & 1;
+                constraint.possibleBlacks[position] = constraint.possibleBlacks[position + 1] + (canBeBlack ? 1 : 0);
+            }
+        }
+    }
+
+    //! First returns the consistent code with the smallest index, or nothing when no code is consistent
+    std::optional<Code> First()
+    {
+        return Search(nullptr);
+    }
+
+    //! Random returns a consistent code found by trying colors in a random order, or nothing when no code is consistent
+    std::optional<Code> Random( std::mt19937_64& random )
+    {
+        return Search(&random);
+    }
+
+    //! NodeCount is the number of pegs the searches assigned
+    long long NodeCount() const
+    {
+        return nodeCount;
+    }
+
+private:
+    //! Constraint is one past guess with its feedback and the blacks and matches of the pegs assigned so far
+    struct Constraint
+    {
+        CodeArray pegs{};
+        std::array<int, Config::MaxColors + 1> colorCounts{};
+        int blackCount = 0;
+        int matchCount = 0;
+        //! possibleBlacks[position] is the number of positions from position on whose domain has the color of the guess
+        std::array<int, Config::MaxLength + 1> possibleBlacks{};
+        int blacks = 0;
+        int matches = 0;
+    };
+
+    std::optional<Code> Search( std::mt19937_64* random )
+    {
+        CodeArray pegs{};
+        std::array<int, Config::MaxColors + 1> pegColorCounts{};
+        for ( auto& constraint : constraints )
+            constraint.blacks = constraint.matches = 0;
+        if ( Assign(0, pegs, pegColorCounts, random) )
+            return Code(pegs);
+        return std::nullopt;
+    }
+
+    bool Assign( int position, CodeArray& pegs, std::array<int, Config::MaxColors + 1>& pegColorCounts, std::mt19937_64* random )
+    {
+        if ( position == Config::LengthOfSecret() )
+            return true;
+
+        std::array<int, Config::MaxColors> colors;
+        std::iota(colors.begin(), colors.begin() + Config::ColorCount(), 1);
+        if ( random )
+            std::shuffle(colors.begin(), colors.begin() + Config::ColorCount(), *random);
+        const int positionsLeft = Config::LengthOfSecret() - position - 1;
+        for ( int i = 0; i < Config::ColorCount(); i++ )
+        {
+            const int color = colors[i];
+            if ( ((domains[position] >> color) & 1) == 0 )
+                continue;
+            nodeCount++;
+            pegs[position] = color;
+            pegColorCounts[color]++;
+            bool isFeasible = true;
+            for ( auto& constraint : constraints )
+            {
+                constraint.blacks += constraint.pegs[position] == color ? 1 : 0;
+                constraint.matches += pegColorCounts[color] <= constraint.colorCounts[color] ? 1 : 0;
+                isFeasible = isFeasible && constraint.blacks <= constraint.blackCount && constraint.matches <= constraint.matchCount &&
+                             constraint.blacks + constraint.possibleBlacks[position + 1] >= constraint.blackCount &&
+                             constraint.matches + positionsLeft >= constraint.matchCount;
+            }
+            if ( isFeasible && Assign(position + 1, pegs, pegColorCounts, random) )
+                return true;
+            for ( auto& constraint : constraints )
+            {
+                constraint.blacks -= constraint.pegs[position] == color ? 1 : 0;
+                constraint.matches -= pegColorCounts[color] <= constraint.colorCounts[color] ? 1 : 0;
+            }
+            pegColorCounts[color]--;
+        }
+        return false;
+    }
+
+    std::vector<Constraint> constraints;
+    //! domains[position] has bit color set when the peg at position can have color
+    std::array<uint32_t, Config::MaxLength> domains{};
+    long long nodeCount = 0;
+};
+
+using ConsistentCodeFinder = BasicConsistentCodeFinder<Common::ClassicConfig>;
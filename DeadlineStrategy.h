@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Common.h"
+#include "GuessContext.h"
+#include "SearchLimit.h"
+#include "Strategy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+//! DeadlineStrategy returns the guess of another strategy within a time budget for every move
+/*!
+    MiniMax and the partition strategies score every guess of the pool, their cost grows with the number of candidates and the
+    size of the game. This wrapper gives the search of every move a SearchLimit at start + moveBudget:
+    1 - Before the search the guess is a code which can still be the secret, the first candidate. When the budget is already
+        spent it is played without searching.
+    2 - Interruptible strategies(MiniMax, partition strategies, sampled) score codes which can still be the secret first and
+        return the best guess scored when the deadline passes, so the guess only gets better with more time. Lookahead plays the
+        best guess of its policy and genetic the best code of the generations it made.
+    3 - Other strategies finish their search(Optimal, main refuses a deadline for it), a move which was not cut but ended after
+        its deadline is counted as late. A cut move ends a little after the deadline too, when the guess which was being scored
+        is done.
+    Statistics tell how often the deadline cut the search and the slowest move, callbacks are forwarded to the strategy.
+    A move whose search was cut depends on timing, so games with a deadline are not reproducible.
+*/
+template <typename Config>
+class BasicDeadlineStrategy final : public BasicIStrategy<Config>
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using GuessContext = BasicGuessContext<Config>;
+
+    //! Statistics sum all moves, a cut move returned before its search finished, a late move finished it after the deadline
+    struct Statistics
+    {
+        long long moveCount = 0;
+        long long cutMoveCount = 0;
+        long long lateMoveCount = 0;
+        double seconds = 0;
+        double maximumSeconds = 0;
+
+        double CutRate() const
+        {
+            return moveCount > 0 ? static_cast<double>(cutMoveCount) / moveCount : 0;
+        }
+    };
+
+    BasicDeadlineStrategy( std::shared_ptr<BasicIStrategy<Config>> strategy, std::chrono::milliseconds moveBudget )
+        : strategy(std::move(strategy)), moveBudget(moveBudget)
+    {
+    }
+
+    virtual Code Guess( const GuessContext& context ) override
+    {
+        const auto start = SearchLimit::Clock::now();
+        const SearchLimit searchLimit(Deadline(start));
+        Code returnVal = Code::FromIndex(context.IsEnumerated() ? static_cast<int>(context.Candidates().First()) : 0);
+        bool isCut = true;
+        if ( !context.IsEnumerated() || !searchLimit.ShouldStop() )
+        {
+            strategy->SetSearchLimit(&searchLimit);
+            returnVal = strategy->Guess(context);
+            strategy->SetSearchLimit(nullptr);
+            isCut = searchLimit.IsCut();
+        }
+
+        const auto end = SearchLimit::Clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        statistics.moveCount++;
+        statistics.cutMoveCount += isCut ? 1 : 0;
+        statistics.lateMoveCount += !isCut && end > searchLimit.GetDeadline() ? 1 : 0;
+        statistics.seconds += seconds;
+        statistics.maximumSeconds = std::max(statistics.maximumSeconds, seconds);
+        lastMoveCut = isCut;
+        return returnVal;
+    }
+
+    virtual void OnGameStart( const GuessContext& context ) override
+    {
+        strategy->OnGameStart(context);
+    }
+
+    virtual void OnFeedback( const GuessContext& context, const BasicCandidateSet<Config>& eliminatedCodes ) override
+    {
+        strategy->OnFeedback(context, eliminatedCodes);
+    }
+
+    virtual void OnGameEnd( const GuessContext& context, bool isWon ) override
+    {
+        strategy->OnGameEnd(context, isWon);
+    }
+
+    Statistics GetStatistics() const
+    {
+        return statistics;
+    }
+
+    //! IsLastMoveCut is true when the deadline cut the search of the last guess
+    bool IsLastMoveCut() const
+    {
+        return lastMoveCut;
+    }
+
+private:
+    //! Deadline is start + moveBudget, a budget of milliseconds::max() does not overflow and never stops
+    SearchLimit::Clock::time_point Deadline( SearchLimit::Clock::time_point start ) const
+    {
+        if ( moveBudget >= std::chrono::duration_cast<std::chrono::milliseconds>(SearchLimit::Clock::time_point::max() - start) )
+            return SearchLimit::Clock::time_point::max();
+        return start + moveBudget;
+    }
+
+    std::shared_ptr<BasicIStrategy<Config>> strategy;
+    std::chrono::milliseconds moveBudget;
+    Statistics statistics;
+    bool lastMoveCut = false;
+};
+
+using DeadlineStrategy = BasicDeadlineStrategy<Common::ClassicConfig>;
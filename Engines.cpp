@@ -0,0 +1,6 @@
+#include "Engines.h"
+
+template class BasicGame<Engines::Config5x8>;
+template class BasicGame<Engines::Config6x9>;
+template class BasicGame<Engines::Config4x10>;
+template class BasicGame<Common::RuntimeConfig>;
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Game.h"
+
+#include <array>
+#include <chrono>
+
+//! Engine is the entry point of the game for one configuration
+/*!
+    Every configuration is a different set of template instances. Engines for the common configurations are explicitly
+    instantiated in Engines.cpp and can be selected at runtime from the dispatch table by pegs and colors. Any other size is played
+    by the generic RuntimeConfig engine whose loops are not unrolled.
+*/
+struct Engine
+{
+    int lengthOfSecret;
+    int colorCount;
+    bool isSpecialized;
+    //! Plays one game and returns the index of the winning round or -1, same as Game::StartTheGame
+    /*!
+        A moveBudget bigger than zero bounds the time of every guess of a computer strategy(see Game::SetMoveBudget).
+    */
+    int (*playGame)( Common::GameMode mode, bool isVerbose, std::chrono::milliseconds moveBudget );
+};
+
+namespace Engines
+{
+    using Config4x6 = Common::ClassicConfig;
+    using Config5x8 = Common::GameConfig<5, 8>;
+    using Config6x9 = Common::GameConfig<6, 9>;
+    using Config4x10 = Common::GameConfig<4, 10>;
+
+    template <typename Config>
+    int PlayGame( Common::GameMode mode, bool isVerbose, std::chrono::milliseconds moveBudget )
+    {
+        BasicGame<Config> game(mode);
+        game.SetVerbose(isVerbose);
+        if ( moveBudget > std::chrono::milliseconds::zero() )
+            game.SetMoveBudget(moveBudget);
+        return game.StartTheGame();
+    }
+
+    template <typename Config>
+    constexpr Engine MakeEngine( bool isSpecialized )
+    {
+        return Engine{ Config::LengthOfSecret(), Config::ColorCount(), isSpecialized, &PlayGame<Config> };
+    }
+
+    inline constexpr std::array<Engine, 4> SpecializedEngines = {
+        MakeEngine<Config4x6>(true),
+        MakeEngine<Config5x8>(true),
+        MakeEngine<Config6x9>(true),
+        MakeEngine<Config4x10>(true),
+    };
+
+    //! SelectEngine returns the specialized engine for the size or the generic one configured for the size
+    inline Engine SelectEngine( int lengthOfSecret, int colorCount )
+    {
+        for ( const auto& engine : SpecializedEngines )
+        {
+            if ( engine.lengthOfSecret == lengthOfSecret && engine.colorCount == colorCount )
+                return engine;
+        }
+        Common::RuntimeConfig::Set(lengthOfSecret, colorCount);
+        return MakeEngine<Common::RuntimeConfig>(false);
+    }
+}
+
+extern template class BasicGame<Engines::Config5x8>;
+extern template class BasicGame<Engines::Config6x9>;
+extern template class BasicGame<Engines::Config4x10>;
+extern template class BasicGame<Common::RuntimeConfig>;
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Common.h"
+
+#include <vector>
+
+//! FeedbackMatrix holds the result of every code compared against every other code
+/*!
+    Both elimination and MiniMax need the score of a code against another code millions of times per game.
+    Instead of calling Compare each time, all scores are calculated once per process and stored as FeedbackIds
+    in a CodeCount x CodeCount table which is indexed by Code::GetIndex. For the classic game it is 1296 x 1296 bytes ~ 1.6 MB.
+    The table itself is built with Code::Compare.
+    Table grows quadratically so it is only built when there are at most MaximumCodeCount codes, for bigger games batch scorer is used.
+    There is one matrix per game configuration.
+*/
+template <typename Config>
+class BasicFeedbackMatrix
+{
+public:
+    using Code = Common::BasicCode<Config>;
+
+    static constexpr int MaximumCodeCount = 4096;
+
+    static constexpr bool IsAvailable()
+    {
+        return Common::BasicCodeSpace<Config>::Size() <= MaximumCodeCount;
+    }
+
+    static const BasicFeedbackMatrix& Instance()
+    {
+        static const BasicFeedbackMatrix matrix;
+        return matrix;
+    }
+
+    Common::FeedbackId Get( int guessIndex, int candidateIndex ) const
+    {
+        return feedbacks[static_cast<size_t>(guessIndex) * codeCount + candidateIndex];
+    }
+
+    Common::FeedbackId Get( const Code& guess, const Code& candidate ) const
+    {
+        return Get(guess.GetIndex(), candidate.GetIndex());
+    }
+
+    //! Row returns the feedbacks of a guess against all codes in index order
+    const Common::FeedbackId* Row( int guessIndex ) const
+    {
+        return feedbacks.data() + static_cast<size_t>(guessIndex) * codeCount;
+    }
+
+    int GetCodeCount() const
+    {
+        return codeCount;
+    }
+
+private:
+    BasicFeedbackMatrix() : codeCount(IsAvailable() ? Common::GetCodeCount<Config>() : 0)
+    {
+        auto allCodesView = Common::AllCodesView<Config>();
+        std::vector<Code> codes(allCodesView.begin(), allCodesView.begin() + codeCount);
+
+        feedbacks.resize(static_cast<size_t>(codeCount) * codeCount);
+        for ( int guessIndex = 0; guessIndex < codeCount; guessIndex++ )
+        {
+            // Score is symmetric so only the upper triangle is calculated
+            for ( int candidateIndex = guessIndex; candidateIndex < codeCount; candidateIndex++ )
+            {
+                auto id = codes[guessIndex].Compare(codes[candidateIndex]).template ToFeedbackId<Config>();
+                feedbacks[static_cast<size_t>(guessIndex) * codeCount + candidateIndex] = id;
+                feedbacks[static_cast<size_t>(candidateIndex) * codeCount + guessIndex] = id;
+            }
+        }
+    }
+
+    int codeCount;
+    std::vector<Common::FeedbackId> feedbacks;
+};
+
+using FeedbackMatrix = BasicFeedbackMatrix<Common::ClassicConfig>;
@@ -2,76 +2,199 @@
 
 #include "CodeBreaker.h"
 #include "CodeMaker.h"
+#include "DeadlineStrategy.h"
+#include "GeneticStrategy.h"
+#include "LookaheadStrategy.h"
+#include "OpeningBook.h"
+#include "OptimalStrategy.h"
+#include "PortfolioStrategy.h"
+#include "SampledStrategy.h"
+
+#include <limits>
+
+//! GameLimits are the biggest games, by number of codes, which every mode plays in reasonable time
+namespace GameLimits
+{
+    //! ExactSearchCodeCount is the biggest game partition strategies search exactly, 5 pegs 8 colors, bigger ones are sampled
+    constexpr uint64_t ExactSearchCodeCount = 32768;
+    //! EnumeratedCodeCount is the biggest game strategies which list all codes can play, 8 pegs 8 colors
+    constexpr uint64_t EnumeratedCodeCount = 1ULL << 24;
+    //! OptimalCodeCount is the classic game, searching its whole tree already takes about half a minute
+    constexpr uint64_t OptimalCodeCount = 1296;
+
+    //! MaximumCodeCount is the biggest game mode can play, modes which do not list the codes play any size
+    constexpr uint64_t MaximumCodeCount( Common::GameMode mode )
+    {
+        if ( mode == Common::GameMode::Human || mode == Common::GameMode::Swaszek || mode == Common::GameMode::Genetic )
+            return std::numeric_limits<uint64_t>::max();
+        if ( mode == Common::GameMode::Optimal )
+            return OptimalCodeCount;
+        if ( mode == Common::GameMode::Lookahead )
+            return ExactSearchCodeCount;
+        return EnumeratedCodeCount;
+    }
+}
 
 //! Game mediates between CodeBreaker and CodeKeeper
 /*!
     Game has two responsibilities first it runs the game by mediating between CodeBreaker and CodeKeeper.
     Second it helps CodeBreaker's initilization by setting it strategy and feeding all possible inputs.
+    When an opening book is installed for the mode, computer strategies answer from the book. Human, Swaszek and genetic games do
+    not enumerate the codes(see CodeBreaker::StartWithoutEnumeration) so they can be played on any size, other modes are limited
+    by GameLimits::MaximumCodeCount. MiniMax and partition games bigger than ExactSearchCodeCount are played by the sampled
+    strategy of the same policy. Portfolio games race MiniMax, entropy, sampled MiniMax and Swaszek for every guess, sampled
+    members only in bigger games, and print which of them won the round. SetMoveBudget bounds the time a computer strategy thinks about
+    a guess(see DeadlineStrategy).
+    It is a template on game configuration, Game is the classic game.
 */
-class Game
+template <typename Config>
+class BasicGame
 {
 public:
-    Game( Common::GameMode mode ) : gameMode(mode)
+    using Code = Common::BasicCode<Config>;
+
+    BasicGame( Common::GameMode mode ) : gameMode(mode)
     {
-        codeBreaker.SetAllCodes(GenerateAllPossibleCodes());
+        const bool isSampled = Common::BasicCodeSpace<Config>::Size() > GameLimits::ExactSearchCodeCount;
+        if ( mode == Common::GameMode::Human || mode == Common::GameMode::Swaszek || mode == Common::GameMode::Genetic )
+            codeBreaker.StartWithoutEnumeration();
+        else
+            codeBreaker.SetAllCodes(GenerateAllPossibleCodes());
 
         if ( mode == Common::GameMode::Human )
         {
-            codeBreaker.SetStrategy(std::make_shared<HumanStrategy>());
+            codeBreaker.SetStrategy(std::make_shared<BasicHumanStrategy<Config>>());
+        }
+        else if ( mode == Common::GameMode::MiniMax && isSampled )
+        {
+            SetComputerStrategy(std::make_shared<BasicSampledMiniMaxStrategy<Config>>());
         }
         else if ( mode == Common::GameMode::MiniMax)
         {
-            codeBreaker.SetStrategy(std::make_shared<MiniMaxStrategy>());
+            SetComputerStrategy(std::make_shared<BasicMiniMaxStrategy<Config>>());
+        }
+        else if ( mode == Common::GameMode::Entropy )
+        {
+            SetComputerStrategy(PartitionStrategy<PartitionPolicy::Entropy>(isSampled));
+        }
+        else if ( mode == Common::GameMode::ExpectedSize )
+        {
+            SetComputerStrategy(PartitionStrategy<PartitionPolicy::ExpectedSize>(isSampled));
+        }
+        else if ( mode == Common::GameMode::MostParts )
+        {
+            SetComputerStrategy(PartitionStrategy<PartitionPolicy::MostParts>(isSampled));
+        }
+        else if ( mode == Common::GameMode::Optimal )
+        {
+            SetComputerStrategy(std::make_shared<BasicOptimalStrategy<Config>>());
+        }
+        else if ( mode == Common::GameMode::Genetic )
+        {
+            geneticStrategy = std::make_shared<BasicGeneticStrategy<Config>>();
+            SetComputerStrategy(geneticStrategy);
+        }
+        else if ( mode == Common::GameMode::Lookahead )
+        {
+            SetComputerStrategy(std::make_shared<BasicLookaheadStrategy<Config>>());
+        }
+        else if ( mode == Common::GameMode::Portfolio )
+        {
+            portfolioStrategy = std::make_shared<BasicPortfolioStrategy<Config>>(isSampled ? BasicPortfolioStrategy<Config>::SampledMembers()
+                                                                                           : BasicPortfolioStrategy<Config>::DefaultMembers());
+            SetComputerStrategy(portfolioStrategy);
         }
         else
         {
-            codeBreaker.SetStrategy(std::make_shared<SwaszekStrategy>());
+            SetComputerStrategy(std::make_shared<BasicSwaszekStrategy<Config>>());
         }
     }
 
+    //! SetMoveBudget plays every guess of the computer strategy within moveBudget, it should be called before the game starts
+    void SetMoveBudget( std::chrono::milliseconds moveBudget )
+    {
+        if ( !computerStrategy )
+            return;
+        deadlineStrategy = std::make_shared<BasicDeadlineStrategy<Config>>(computerStrategy, moveBudget);
+        codeBreaker.SetStrategy(deadlineStrategy);
+    }
+
+    //! SetVerbose enables or disables printing the progress of the game, simulations turn it off
+    void SetVerbose( bool isVerbose )
+    {
+        this->isVerbose = isVerbose;
+    }
+
     int StartTheGame()
     {
-        if ( gameMode != Common::GameMode::Human )
+        if ( isVerbose && gameMode != Common::GameMode::Human )
             std::cout << "Human observer secret is: " << codeMaker.GetSecretCode().ToString() << std::endl;
-        for ( int i = 0; i < MaximumRoundCount; i++ )
+        for ( int i = 0; i < Config::MaximumRoundCount(); i++ )
         {
+            const long long searchCount = geneticStrategy ? geneticStrategy->GetStatistics().searchCount : 0;
             auto guess = codeBreaker.Guess();
-            std::cout << "Code breaker's " << i << ". guess was "  << guess.ToString() << std::endl;
+            if ( isVerbose )
+                std::cout << "Code breaker's " << i << ". guess was "  << guess.ToString() << std::endl;
+            // Fixed opening and the last candidate are played without a search, so there is nothing to tell about them
+            if ( isVerbose && geneticStrategy && geneticStrategy->GetStatistics().searchCount > searchCount )
+                std::cout << "It was chosen from " << geneticStrategy->GetStatistics().eligibleCount << " eligible codes, "
+                          << geneticStrategy->GetStatistics().EvaluationsPerSecond() << " evaluations/second" << std::endl;
+            if ( isVerbose && portfolioStrategy && portfolioStrategy->GetRoundWinners().size() == static_cast<size_t>(i + 1) )
+                std::cout << "Guess of " << portfolioStrategy->GetMembers()[portfolioStrategy->GetRoundWinners().back()].name
+                          << " won the round" << std::endl;
+            if ( isVerbose && deadlineStrategy && deadlineStrategy->IsLastMoveCut() )
+                std::cout << "Search was cut at the deadline, the best guess found so far was played" << std::endl;
             auto result = codeMaker.GetResultOfGuess(guess);
-            std::cout << "Code maker's judgement: " <<  result.ToString() << std::endl;
-            codeBreaker.SetResult(result);
-            if ( result.blackCount == LengthOfSecret )
+            if ( isVerbose )
+                std::cout << "Code maker's judgement: " <<  result.ToString() << std::endl;
+            auto feedback = result.template ToFeedbackId<Config>();
+            codeBreaker.SetResult(feedback);
+            if ( feedback == Common::GetWinningFeedback<Config>() )
             {
-                if ( gameMode == Common::GameMode::Human )
+                if ( isVerbose && gameMode == Common::GameMode::Human )
                     std::cout << "You won!! It took you : " << i << " rounds " << std::endl;
-                else
+                else if ( isVerbose )
                     std::cout << "It took computer to won in : " << i << " rounds " << std::endl;
                 return i;
             }
         }
-        std::cout << "Code was not cracked! Codebreaker loses codekeeper wins" << std::endl;
+        if ( isVerbose )
+            std::cout << "Code was not cracked! Codebreaker loses codekeeper wins" << std::endl;
         return -1;
     }
 
-    std::vector<Common::Code> GenerateAllPossibleCodes()
+    std::vector<Code> GenerateAllPossibleCodes()
     {
-        std::vector<Common::Code> returnVal;
-        int startingInt = Common::GetStartingInteger();
-        Common::Code code(startingInt);
-        returnVal.push_back(code);
-        while ( true )
-        {
-            auto newCode = Common::Code(code.NextCode());
-            if ( newCode == code)
-                break;
-            returnVal.push_back(newCode);
-            code = newCode;
-        }
-        return returnVal;
+        auto allCodesView = Common::AllCodesView<Config>();
+        return std::vector<Code>(allCodesView.begin(), allCodesView.end());
     }
 
 private:
+    //! PartitionStrategy is the exact strategy of Policy, or the sampled one when isSampled is true
+    template <typename Policy>
+    static std::shared_ptr<BasicIStrategy<Config>> PartitionStrategy( bool isSampled )
+    {
+        if ( isSampled )
+            return std::make_shared<BasicSampledStrategy<Config, Policy>>();
+        return std::make_shared<BasicPartitionStrategy<Config, Policy>>();
+    }
+
+    void SetComputerStrategy( std::shared_ptr<BasicIStrategy<Config>> strategy )
+    {
+        if ( auto book = BasicOpeningBook<Config>::Installed(gameMode) )
+            strategy = std::make_shared<BasicBookStrategy<Config>>(book, strategy);
+        computerStrategy = strategy;
+        codeBreaker.SetStrategy(strategy);
+    }
+
+    bool isVerbose = true;
     Common::GameMode gameMode;
-    CodeBreaker codeBreaker;
-    CodeMaker   codeMaker;
-};
\ No newline at end of file
+    std::shared_ptr<BasicGeneticStrategy<Config>> geneticStrategy;
+    std::shared_ptr<BasicPortfolioStrategy<Config>> portfolioStrategy;
+    std::shared_ptr<BasicIStrategy<Config>> computerStrategy;
+    std::shared_ptr<BasicDeadlineStrategy<Config>> deadlineStrategy;
+    BasicCodeBreaker<Config> codeBreaker;
+    BasicCodeMaker<Config>   codeMaker;
+};
+
+using Game = BasicGame<Common::ClassicConfig>;
\ No newline at end of file
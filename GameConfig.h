@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdexcept>
+
+namespace Common
+{
+    //! GameConfig describes a variant of the game at compile time
+    /*!
+        Every part of the engine(Code, Compare, CodeBreaker, strategies and Game) is a template on a configuration type.
+        A configuration provides:
+        1 - MaxLength and MaxColors which are compile time capacities, used for sizes of arrays and packed words.
+        2 - LengthOfSecret(), ColorCount() and MaximumRoundCount() which are the actual sizes of the game.
+        For GameConfig they are equal to the capacities and constexpr so compiler unrolls all loops over pegs and colors.
+    */
+    template <int Pegs, int Colors, int MaximumRounds = 10>
+    struct GameConfig
+    {
+        static constexpr int MaxLength = Pegs;
+        static constexpr int MaxColors = Colors;
+
+        static constexpr int LengthOfSecret()
+        {
+            return Pegs;
+        }
+
+        static constexpr int ColorCount()
+        {
+            return Colors;
+        }
+
+        static constexpr int MaximumRoundCount()
+        {
+            return MaximumRounds;
+        }
+    };
+
+    //! RuntimeConfig is the generic fallback for configurations which do not have a specialized engine
+    /*!
+        Sizes are only known at runtime so loops can not be unrolled, but any game up to 15 pegs and 15 colors can be played.
+        Sizes are process wide, they should be set once with Set before any code of this configuration is created.
+    */
+    struct RuntimeConfig
+    {
+        static constexpr int MaxLength = 15;
+        static constexpr int MaxColors = 15;
+
+        static int LengthOfSecret()
+        {
+            return lengthOfSecret;
+        }
+
+        static int ColorCount()
+        {
+            return colorCount;
+        }
+
+        static int MaximumRoundCount()
+        {
+            return maximumRoundCount;
+        }
+
+        static void Set( int length, int colors, int maximumRounds = 10 )
+        {
+            if ( length < 1 || length > MaxLength || colors < 1 || colors > MaxColors )
+                throw std::invalid_argument("Runtime configuration supports 1 to 15 pegs and 1 to 15 colors");
+            lengthOfSecret = length;
+            colorCount = colors;
+            maximumRoundCount = maximumRounds;
+        }
+
+    private:
+        static inline int lengthOfSecret = 4;
+        static inline int colorCount = 6;
+        static inline int maximumRoundCount = 10;
+    };
+
+    //! ClassicConfig is the original game, 4 pegs with 6 colors in 10 rounds
+    using ClassicConfig = GameConfig<4, 6>;
+}
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "BatchScorer.h"
+#include "Common.h"
+#include "GuessContext.h"
+#include "PartitionPolicy.h"
+#include "Strategy.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+//! GeneticStrategy guesses codes which can still be the secret without enumerating the codes of the game
+/*!
+    Strategies which search the guess pool need all codes and all candidates, 8 pegs and 12 colors have 430 million codes so they
+    can not play it. This is the genetic algorithm of Berghman, Goossens and Leus which only needs the history. For every guess:
+    1 - A population of random codes evolves. A child copies the pegs of one parent and the pegs between two random cut points
+        of another, parents are taken from the fitter half of the population. Then with some probability a peg gets a random
+        color(mutation), two pegs are swapped(permutation) and pegs between two positions are reversed(inversion). Fittest tenth of
+        the population survives unchanged, a child which is already in the new population is replaced by a random code.
+    2 - Fitness of a code is the sum over past guesses of |blacks - past blacks| + |whites - past whites|, where blacks and whites
+        are the feedback the past guess would get if the code was the secret. Lower is fitter. Fitness of a generation is computed
+        in parallel on ThreadPool::Instance(), every thread scores each past guess against its slice of the population with the
+        batch kernels.
+    3 - Codes with fitness 0 are eligible, they can still be the secret. Evolution stops after generationBudget generations or when
+        eligibleCapacity different eligible codes are found. While no code is eligible it goes on up to generationLimit generations.
+        Time budget or a SearchLimit stops it in every case, if nothing is eligible then the fittest code is played.
+    4 - Eligible codes are a sample of the candidates, guess is the eligible code which leaves least of the others on average
+        (PartitionPolicy::ExpectedSize).
+    Random numbers are seeded from seed and the history, so like other strategies the guess only depends on the history and not on
+    the number of threads, unless the time budget runs out. An eligible code is never a past guess since it would have won.
+*/
+template <typename Config>
+class BasicGeneticStrategy final : public BasicIStrategy<Config>
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using PackedCode = Common::BasicPackedCode<Config>;
+    using GuessContext = BasicGuessContext<Config>;
+
+    //! Settings of the search for one guess, population size and eligible capacity are the values of Berghman et al.
+    struct Settings
+    {
+        int populationSize = 150;
+        int generationBudget = 100;
+        int generationLimit = 10000;
+        size_t eligibleCapacity = 60;
+        std::chrono::milliseconds timeBudget{ 2000 };
+        uint64_t seed = 0x9E3779B97F4A7C15;
+    };
+
+    //! SearchStatistics sums the searches of all guesses, eligibleCount is the number of eligible codes of the last search
+    struct SearchStatistics
+    {
+        long long searchCount = 0;
+        long long generationCount = 0;
+        long long evaluationCount = 0;
+        double seconds = 0;
+        size_t eligibleCount = 0;
+
+        double EvaluationsPerSecond() const
+        {
+            return seconds > 0 ? evaluationCount / seconds : 0;
+        }
+    };
+
+    BasicGeneticStrategy() : BasicGeneticStrategy(Settings{})
+    {
+    }
+
+    explicit BasicGeneticStrategy( const Settings& settings ) : settings(settings), feedbackCount(Common::GetFeedbackCount<Config>()),
+                                                                distances(feedbackCount * feedbackCount)
+    {
+        for ( int lhs = 0; lhs < feedbackCount; lhs++ )
+        {
+            for ( int rhs = 0; rhs < feedbackCount; rhs++ )
+            {
+                auto lhsResult = Common::Result::FromFeedbackId<Config>(static_cast<Common::FeedbackId>(lhs));
+                auto rhsResult = Common::Result::FromFeedbackId<Config>(static_cast<Common::FeedbackId>(rhs));
+                distances[lhs * feedbackCount + rhs] = std::abs(lhsResult.blackCount - rhsResult.blackCount) +
+                                                       std::abs(lhsResult.whiteCount - rhsResult.whiteCount);
+            }
+        }
+    }
+
+    virtual Code Guess( const GuessContext& context ) override
+    {
+        if ( context.PastGuesses().empty() )
+            return FirstGuess();
+
+        const auto start = std::chrono::steady_clock::now();
+        std::mt19937_64 random(context.HistorySeed(settings.seed));
+        std::vector<PackedCode> population(settings.populationSize);
+        for ( auto& code : population )
+            code = RandomCode(random);
+        std::vector<int> fitness(population.size());
+        std::vector<Code> eligibleCodes;
+        std::unordered_set<typename PackedCode::Word> eligibleBits;
+        int generationCount = 0;
+        while ( true )
+        {
+            Evaluate(context, population, fitness);
+            generationCount++;
+            for ( size_t i = 0; i < population.size() && eligibleCodes.size() < settings.eligibleCapacity; i++ )
+            {
+                if ( fitness[i] == 0 && eligibleBits.insert(population[i].bits).second )
+                    eligibleCodes.push_back(Code(population[i]));
+            }
+            const int generationBudget = eligibleCodes.empty() ? settings.generationLimit : settings.generationBudget;
+            if ( eligibleCodes.size() >= settings.eligibleCapacity || generationCount >= generationBudget ||
+                 std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start) >= settings.timeBudget ||
+                 (searchLimit && searchLimit->ShouldStop()) )
+                break;
+            population = NextGeneration(population, fitness, random);
+        }
+
+        statistics.searchCount++;
+        statistics.generationCount += generationCount;
+        statistics.evaluationCount += static_cast<long long>(generationCount) * settings.populationSize;
+        statistics.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        statistics.eligibleCount = eligibleCodes.size();
+        if ( eligibleCodes.empty() )
+            return Code(population[std::ranges::min_element(fitness) - fitness.begin()]);
+        return BestEligible(context, eligibleCodes);
+    }
+
+    virtual void SetSearchLimit( const SearchLimit* searchLimit ) override
+    {
+        this->searchLimit = searchLimit;
+    }
+
+    SearchStatistics GetStatistics() const
+    {
+        return statistics;
+    }
+
+private:
+    using CodeArray = typename Code::CodeArray;
+
+    //! Probabilities of the operators for a child, they are higher than the rates of Berghman et al. which stall on 8 pegs 12 colors
+    static constexpr double MutationRate = 0.5;
+    static constexpr double PermutationRate = 0.2;
+    static constexpr double InversionRate = 0.1;
+
+    //! FirstGuess pairs the pegs, 1122 for the classic game and 11223344 for 8 pegs
+    static Code FirstGuess()
+    {
+        CodeArray colorCodeList{};
+        for ( int i = 0; i < Config::LengthOfSecret(); i++ )
+            colorCodeList[i] = (i / 2) % Config::ColorCount() + 1;
+        return Code(colorCodeList);
+    }
+
+    //! Evaluate writes the fitness of every code of population to fitness
+    void Evaluate( const GuessContext& context, const std::vector<PackedCode>& population, std::vector<int>& fitness ) const
+    {
+        const auto& pastGuesses = context.PastGuesses();
+        const auto& pastFeedbacks = context.PastFeedbacks();
+        auto feedbacks = context.FeedbackScratch(population.size());
+        std::ranges::fill(fitness, 0);
+        ThreadPool::Instance().ParallelFor(population.size(), [&]( size_t, size_t begin, size_t end ){
+            const std::span<const PackedCode> slice(population.data() + begin, end - begin);
+            for ( size_t i = 0; i < pastFeedbacks.size(); i++ )
+            {
+                Common::ScoreAgainst(pastGuesses[i].GetPacked(), slice, feedbacks.subspan(begin, end - begin));
+                for ( size_t j = begin; j < end; j++ )
+                    fitness[j] += distances[feedbacks[j] * feedbackCount + pastFeedbacks[i]];
+            }
+        });
+    }
+
+    std::vector<PackedCode> NextGeneration( const std::vector<PackedCode>& population, const std::vector<int>& fitness,
+                                            std::mt19937_64& random ) const
+    {
+        std::vector<size_t> order(population.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::ranges::stable_sort(order, [&fitness]( size_t lhs, size_t rhs ){
+            return fitness[lhs] < fitness[rhs];
+        });
+        std::uniform_int_distribution<size_t> parentDistribution(0, std::max<size_t>(population.size() / 2, 1) - 1);
+
+        std::vector<PackedCode> returnVal;
+        returnVal.reserve(population.size());
+        std::unordered_set<typename PackedCode::Word> childBits;
+        for ( size_t i = 0; i < population.size() / 10; i++ )
+        {
+            returnVal.push_back(population[order[i]]);
+            childBits.insert(population[order[i]].bits);
+        }
+        while ( returnVal.size() < population.size() )
+        {
+            auto child = Crossover(population[order[parentDistribution(random)]], population[order[parentDistribution(random)]], random);
+            if ( !childBits.insert(child.bits).second )
+            {
+                child = RandomCode(random);
+                childBits.insert(child.bits);
+            }
+            returnVal.push_back(child);
+        }
+        return returnVal;
+    }
+
+    //! Crossover makes a child of two parents and applies mutation, permutation and inversion to it
+    static PackedCode Crossover( PackedCode lhs, PackedCode rhs, std::mt19937_64& random )
+    {
+        const int length = Config::LengthOfSecret();
+        std::uniform_int_distribution<int> cutDistribution(0, length);
+        std::uniform_int_distribution<int> positionDistribution(0, length - 1);
+        std::uniform_int_distribution<int> colorDistribution(1, Config::ColorCount());
+        std::uniform_real_distribution<double> probabilityDistribution(0, 1);
+
+        CodeArray child = lhs.ToArray();
+        const CodeArray rhsPegs = rhs.ToArray();
+        auto [first, last] = std::minmax(cutDistribution(random), cutDistribution(random));
+        std::copy(rhsPegs.begin() + first, rhsPegs.begin() + last, child.begin() + first);
+
+        if ( probabilityDistribution(random) < MutationRate )
+            child[positionDistribution(random)] = colorDistribution(random);
+        if ( probabilityDistribution(random) < PermutationRate )
+            std::swap(child[positionDistribution(random)], child[positionDistribution(random)]);
+        if ( probabilityDistribution(random) < InversionRate )
+        {
+            auto [begin, end] = std::minmax(cutDistribution(random), cutDistribution(random));
+            std::reverse(child.begin() + begin, child.begin() + end);
+        }
+        return PackedCode::FromArray(child);
+    }
+
+    static PackedCode RandomCode( std::mt19937_64& random )
+    {
+        std::uniform_int_distribution<int> colorDistribution(1, Config::ColorCount());
+        CodeArray colorCodeList{};
+        for ( int i = 0; i < Config::LengthOfSecret(); i++ )
+            colorCodeList[i] = colorDistribution(random);
+        return PackedCode::FromArray(colorCodeList);
+    }
+
+    //! BestEligible returns the eligible code whose partitions of the eligible codes have the smallest expected size
+    Code BestEligible( const GuessContext& context, const std::vector<Code>& eligibleCodes ) const
+    {
+        const BasicCandidateScorer<Config> scorer(eligibleCodes);
+        const PartitionPolicy::ExpectedSize policy(eligibleCodes.size(), feedbackCount);
+        auto buffer = context.FeedbackScratch(eligibleCodes.size());
+        uint64_t bestScore = std::numeric_limits<uint64_t>::max();
+        size_t bestIndex = 0;
+        for ( size_t i = 0; i < eligibleCodes.size(); i++ )
+        {
+            uint64_t score = scorer.ScorePartitions(eligibleCodes[i], policy, bestScore, buffer).score;
+            if ( score < bestScore )
+            {
+                bestScore = score;
+                bestIndex = i;
+            }
+        }
+        return eligibleCodes[bestIndex];
+    }
+
+    Settings settings;
+    int feedbackCount;
+    //! distances[lhs * feedbackCount + rhs] is |black difference| + |white difference| of two feedbacks
+    std::vector<int> distances;
+    const SearchLimit* searchLimit = nullptr;
+    SearchStatistics statistics;
+};
+
+using GeneticStrategy = BasicGeneticStrategy<Common::ClassicConfig>;
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "CandidateSet.h"
+#include "Common.h"
+#include "FeedbackMatrix.h"
+#include "Symmetry.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+//! GuessContext is the state of a game which CodeBreaker shares with its strategy
+/*!
+    CodeBreaker owns one GuessContext and updates it after every guess and feedback, strategies read it in Guess and in the
+    callbacks of IStrategy. So a strategy does not rebuild what the previous move already knew. It holds:
+    1 - All codes of the game and the guess pool. Guess pool is one representative of each symmetry class of all codes given past
+        guesses(see Symmetry), it is computed the first time it is asked for in a move.
+    2 - Codes which can still be the secret as a CandidateSet and as a span of their indexes in increasing order.
+    3 - Past guesses with their feedbacks, pastFeedbacks[i] is the feedback of pastGuesses[i]. IsGuessed checks a code in O(1).
+    4 - FeedbackMatrix of the configuration, nullptr when the configuration is too big for one.
+    5 - Scratch buffers which keep their memory between moves. Content of a buffer is unspecified and it is valid until the next
+        call for a buffer of the same type on the same thread. Every thread has its own buffers, so strategies which search one
+        context at the same time on different threads do not share them(see PortfolioStrategy).
+    A game which is started with StartWithoutEnumeration does not list its codes, it is for code spaces which are too big to enumerate
+    like 8 pegs and 12 colors. Then only the history(3) and the scratch buffers are kept, all codes, guess pool and candidates are
+    empty. Only strategies which generate their own guesses(see GeneticStrategy) can play such a game.
+*/
+template <typename Config>
+class BasicGuessContext
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using CandidateSet = BasicCandidateSet<Config>;
+    using FeedbackMatrix = BasicFeedbackMatrix<Config>;
+
+    //! Start begins a new game in which every code of allCodes can be the secret
+    void Start( const std::vector<Code>& allCodes )
+    {
+        this->allCodes = allCodes;
+        pastGuesses.clear();
+        pastFeedbacks.clear();
+        guessedCodes = CandidateSet();
+        SetCandidates(CandidateSet(allCodes));
+        hasGuessPool = false;
+        isEnumerated = true;
+    }
+
+    //! StartWithoutEnumeration begins a new game in which every code can be the secret without listing the codes
+    void StartWithoutEnumeration()
+    {
+        allCodes.clear();
+        pastGuesses.clear();
+        pastFeedbacks.clear();
+        guessedCodes = CandidateSet::Placeholder();
+        candidates = CandidateSet::Placeholder();
+        candidateIndexes.clear();
+        guessPool.clear();
+        hasGuessPool = true;
+        isEnumerated = false;
+    }
+
+    void AddGuess( const Code& guess )
+    {
+        pastGuesses.push_back(guess);
+        if ( isEnumerated )
+        {
+            guessedCodes.Insert(guess.GetIndex());
+            hasGuessPool = false;
+        }
+    }
+
+    //! AddFeedback records the feedback of the last guess and the codes which can still be the secret after it
+    void AddFeedback( Common::FeedbackId feedback, const CandidateSet& remainingCodes )
+    {
+        pastFeedbacks.push_back(feedback);
+        SetCandidates(remainingCodes);
+    }
+
+    //! AddFeedback records the feedback of the last guess of a game which is not enumerated
+    void AddFeedback( Common::FeedbackId feedback )
+    {
+        pastFeedbacks.push_back(feedback);
+    }
+
+    //! SetSymmetryReduction turns reducing the guess pool by symmetry on or off, it is on by default
+    void SetSymmetryReduction( bool isSymmetryReducing )
+    {
+        this->isSymmetryReducing = isSymmetryReducing;
+        hasGuessPool = !isEnumerated;
+    }
+
+    //! IsEnumerated is false when the game was started without listing its codes
+    bool IsEnumerated() const
+    {
+        return isEnumerated;
+    }
+
+    const std::vector<Code>& AllCodes() const
+    {
+        return allCodes;
+    }
+
+    //! GuessPool is the codes a strategy which searches for the best guess should search
+    /*!
+        A strategy may only use it when its choice depends on nothing else than how a guess partitions Candidates, since a
+        guess and its symmetric images partition them the same way.
+        It is computed by the first call of a move, so it should be called once before strategies read the context from several threads.
+    */
+    const std::vector<Code>& GuessPool() const
+    {
+        if ( !isSymmetryReducing )
+            return allCodes;
+        if ( !hasGuessPool )
+        {
+            guessPool = BasicSymmetry<Config>(pastGuesses).Representatives(allCodes);
+            hasGuessPool = true;
+        }
+        return guessPool;
+    }
+
+    const CandidateSet& Candidates() const
+    {
+        return candidates;
+    }
+
+    std::span<const int> CandidateIndexes() const
+    {
+        return candidateIndexes;
+    }
+
+    const std::vector<Code>& PastGuesses() const
+    {
+        return pastGuesses;
+    }
+
+    const std::vector<Common::FeedbackId>& PastFeedbacks() const
+    {
+        return pastFeedbacks;
+    }
+
+    bool IsGuessed( int codeIndex ) const
+    {
+        if ( isEnumerated )
+            return guessedCodes.Contains(codeIndex);
+        return std::ranges::any_of(pastGuesses, [codeIndex]( const Code& guess ){
+            return guess.GetIndex() == codeIndex;
+        });
+    }
+
+    //! HistorySeed mixes seed with every past guess and feedback
+    /*!
+        Strategies which use random numbers seed them with it, so like other strategies their guess only depends on the history.
+    */
+    uint64_t HistorySeed( uint64_t seed ) const
+    {
+        for ( size_t i = 0; i < pastFeedbacks.size(); i++ )
+        {
+            seed = Common::Mix64(seed ^ pastGuesses[i].GetPacked().bits);
+            seed = Common::Mix64(seed ^ pastFeedbacks[i]);
+        }
+        return seed;
+    }
+
+    const FeedbackMatrix* GetFeedbackMatrix() const
+    {
+        if ( FeedbackMatrix::IsAvailable() )
+            return &FeedbackMatrix::Instance();
+        else
+            return nullptr;
+    }
+
+    std::span<Common::FeedbackId> FeedbackScratch( size_t size ) const
+    {
+        return Scratch<Common::FeedbackId>(size);
+    }
+
+    std::span<int> IndexScratch( size_t size ) const
+    {
+        return Scratch<int>(size);
+    }
+
+private:
+    //! Scratch returns the buffer of the calling thread for elements of type T, it only grows
+    template <typename T>
+    static std::span<T> Scratch( size_t size )
+    {
+        thread_local std::vector<T> buffer;
+        if ( buffer.size() < size )
+            buffer.resize(size);
+        return std::span<T>(buffer.data(), size);
+    }
+
+    void SetCandidates( const CandidateSet& codes )
+    {
+        candidates = codes;
+        candidateIndexes.clear();
+        candidates.ForEach([this]( size_t index ){
+            candidateIndexes.push_back(static_cast<int>(index));
+        });
+    }
+
+    bool isSymmetryReducing = true;
+    bool isEnumerated = true;
+    std::vector<Code> allCodes;
+    CandidateSet candidates = CandidateSet::Placeholder();
+    std::vector<int> candidateIndexes;
+    std::vector<Code> pastGuesses;
+    std::vector<Common::FeedbackId> pastFeedbacks;
+    CandidateSet guessedCodes = CandidateSet::Placeholder();
+    mutable bool hasGuessPool = false;
+    mutable std::vector<Code> guessPool;
+};
+
+using GuessContext = BasicGuessContext<Common::ClassicConfig>;
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "BatchScorer.h"
+#include "CodeBreaker.h"
+#include "Common.h"
+#include "Strategy.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//! OpeningBook is the decision tree of a deterministic strategy, every guess it makes for every secret
+/*!
+    Computer strategies always make the same guess after the same history, so their whole game tree can be computed once and
+    looked up afterwards. Each node is a guess and it has one child for each feedback the guess can get from codes which can still
+    be the secret. Nodes are stored in breadth first order and children of a node are next to each other, so a node only keeps
+    its guess, index of its first child and a bit mask of feedbacks which have a child(16 bytes per node), so books are limited
+    to 9 pegs which have at most 64 feedbacks.
+    Looking up the guess of a history walks down from the root, O(depth) with no scoring.
+    File format is a Header followed by the nodes, written in the byte order of the machine.
+*/
+template <typename Config>
+class BasicOpeningBook
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using CodeBreaker = BasicCodeBreaker<Config>;
+
+    //! Build expands every game strategy can play, strategy should be deterministic
+    static std::shared_ptr<const BasicOpeningBook> Build( std::shared_ptr<BasicIStrategy<Config>> strategy, Common::GameMode mode )
+    {
+        if ( Common::GetFeedbackCount<Config>() > 64 )
+            throw std::invalid_argument("Opening book child masks support up to 64 feedbacks");
+        auto allCodesView = Common::AllCodesView<Config>();
+        CodeBreaker root( strategy );
+        root.SetAllCodes(std::vector<Code>(allCodesView.begin(), allCodesView.end()));
+
+        auto returnVal = std::make_shared<BasicOpeningBook>();
+        returnVal->mode = mode;
+        returnVal->nodes.push_back(Node{});
+        std::deque<std::pair<CodeBreaker, int>> openNodes;
+        openNodes.emplace_back(std::move(root), 0);
+        while ( !openNodes.empty() )
+        {
+            auto [codeBreaker, depth] = std::move(openNodes.front());
+            openNodes.pop_front();
+            const size_t nodeIndex = returnVal->nodes.size() - openNodes.size() - 1;
+
+            auto guess = codeBreaker.Guess();
+            std::vector<Common::FeedbackId> feedbacks(codeBreaker.GetProbableCodes().Count());
+            BasicCandidateScorer<Config>(codeBreaker.GetProbableCodes()).Score(guess, feedbacks);
+            uint64_t childMask = 0;
+            for ( auto feedback : feedbacks )
+            {
+                if ( feedback != Common::GetWinningFeedback<Config>() && depth + 1 < Config::MaximumRoundCount() )
+                    childMask |= uint64_t{1} << feedback;
+            }
+
+            auto& node = returnVal->nodes[nodeIndex];
+            node.guessIndex = static_cast<uint32_t>(guess.GetIndex());
+            node.firstChild = static_cast<uint32_t>(returnVal->nodes.size());
+            node.childMask = childMask;
+            for ( uint64_t mask = childMask; mask != 0; mask &= mask - 1 )
+            {
+                CodeBreaker child = codeBreaker;
+                child.SetResult(static_cast<Common::FeedbackId>(std::countr_zero(mask)));
+                returnVal->nodes.push_back(Node{});
+                openNodes.emplace_back(std::move(child), depth + 1);
+            }
+        }
+        return returnVal;
+    }
+
+    //! Find returns the guess of the book after the history or nothing when the history is not in the book
+    std::optional<Code> Find( const std::vector<Code>& pastGuesses, const std::vector<Common::FeedbackId>& pastFeedbacks ) const
+    {
+        if ( nodes.empty() )
+            return std::nullopt;
+        uint32_t nodeIndex = 0;
+        for ( size_t i = 0; i < pastGuesses.size(); i++ )
+        {
+            const auto& node = nodes[nodeIndex];
+            if ( i >= pastFeedbacks.size() || node.guessIndex != static_cast<uint32_t>(pastGuesses[i].GetIndex()) ||
+                 ((node.childMask >> pastFeedbacks[i]) & 1) == 0 )
+                return std::nullopt;
+            uint64_t smallerFeedbacks = node.childMask & ((uint64_t{1} << pastFeedbacks[i]) - 1);
+            nodeIndex = node.firstChild + std::popcount(smallerFeedbacks);
+        }
+        return Code::FromIndex(nodes[nodeIndex].guessIndex);
+    }
+
+    void Save( const std::string& path ) const
+    {
+        std::ofstream file(path, std::ios::binary);
+        Header header;
+        header.mode = static_cast<uint8_t>(mode);
+        header.nodeCount = static_cast<uint32_t>(nodes.size());
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(Node));
+        if ( !file )
+            throw std::runtime_error("Opening book could not be written to " + path);
+    }
+
+    static std::shared_ptr<const BasicOpeningBook> Load( const std::string& path )
+    {
+        std::ifstream file(path, std::ios::binary);
+        Header header;
+        Header expectedHeader;
+        if ( !file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != expectedHeader.magic ||
+             header.version != expectedHeader.version || header.lengthOfSecret != expectedHeader.lengthOfSecret ||
+             header.colorCount != expectedHeader.colorCount || header.mode >= Common::GameModeCount )
+            throw std::runtime_error(path + " is not an opening book of this game");
+
+        auto returnVal = std::make_shared<BasicOpeningBook>();
+        returnVal->mode = static_cast<Common::GameMode>(header.mode);
+        returnVal->nodes.resize(header.nodeCount);
+        if ( !file.read(reinterpret_cast<char*>(returnVal->nodes.data()), returnVal->nodes.size() * sizeof(Node)) )
+            throw std::runtime_error(path + " is truncated");
+        for ( const auto& node : returnVal->nodes )
+        {
+            if ( node.guessIndex >= static_cast<uint32_t>(Common::GetCodeCount<Config>()) ||
+                 static_cast<uint64_t>(node.firstChild) + std::popcount(node.childMask) > returnVal->nodes.size() )
+                throw std::runtime_error(path + " is corrupted");
+        }
+        return returnVal;
+    }
+
+    size_t NodeCount() const
+    {
+        return nodes.size();
+    }
+
+    Common::GameMode GetMode() const
+    {
+        return mode;
+    }
+
+    //! Install makes Game use the book for games of its mode, books should be installed before games start
+    static void Install( std::shared_ptr<const BasicOpeningBook> book )
+    {
+        installedBooks[static_cast<size_t>(book->GetMode())] = book;
+    }
+
+    static std::shared_ptr<const BasicOpeningBook> Installed( Common::GameMode mode )
+    {
+        return installedBooks[static_cast<size_t>(mode)];
+    }
+
+private:
+    struct Header
+    {
+        std::array<char, 4> magic{ 'M', 'M', 'O', 'B' };
+        uint32_t version = 1;
+        uint8_t lengthOfSecret = static_cast<uint8_t>(Config::LengthOfSecret());
+        uint8_t colorCount = static_cast<uint8_t>(Config::ColorCount());
+        uint8_t mode = 0;
+        uint8_t reserved = 0;
+        uint32_t nodeCount = 0;
+    };
+
+    struct Node
+    {
+        uint32_t guessIndex = 0;
+        uint32_t firstChild = 0;
+        uint64_t childMask = 0;
+    };
+
+    static inline std::array<std::shared_ptr<const BasicOpeningBook>, Common::GameModeCount> installedBooks;
+
+    Common::GameMode mode = Common::GameMode::MiniMax;
+    std::vector<Node> nodes;
+};
+
+//! BookStrategy answers from an opening book and asks the fallback strategy when the history is not in the book
+/*!
+    History leaves the book when a guess was not made by the book's strategy, for example a human playing with hints.
+*/
+template <typename Config>
+class BasicBookStrategy final : public BasicIStrategy<Config>
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using GuessContext = BasicGuessContext<Config>;
+
+    BasicBookStrategy( std::shared_ptr<const BasicOpeningBook<Config>> book, std::shared_ptr<BasicIStrategy<Config>> fallback )
+        : book(std::move(book)), fallback(std::move(fallback))
+    {
+    }
+
+    virtual Code Guess( const GuessContext& context ) override
+    {
+        if ( auto bookGuess = book->Find(context.PastGuesses(), context.PastFeedbacks()) )
+            return *bookGuess;
+        fallbackCount++;
+        return fallback->Guess(context);
+    }
+
+    virtual void OnGameStart( const GuessContext& context ) override
+    {
+        fallback->OnGameStart(context);
+    }
+
+    virtual void OnFeedback( const GuessContext& context, const BasicCandidateSet<Config>& eliminatedCodes ) override
+    {
+        fallback->OnFeedback(context, eliminatedCodes);
+    }
+
+    virtual void OnGameEnd( const GuessContext& context, bool isWon ) override
+    {
+        fallback->OnGameEnd(context, isWon);
+    }
+
+    virtual void SetSearchLimit( const SearchLimit* searchLimit ) override
+    {
+        fallback->SetSearchLimit(searchLimit);
+    }
+
+    //! FallbackCount is how many guesses were not in the book
+    int GetFallbackCount() const
+    {
+        return fallbackCount;
+    }
+
+private:
+    std::shared_ptr<const BasicOpeningBook<Config>> book;
+    std::shared_ptr<BasicIStrategy<Config>> fallback;
+    int fallbackCount = 0;
+};
+
+using OpeningBook = BasicOpeningBook<Common::ClassicConfig>;
+using BookStrategy = BasicBookStrategy<Common::ClassicConfig>;
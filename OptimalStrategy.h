@@ -0,0 +1,275 @@
+#pragma once
+
+#include "BatchScorer.h"
+#include "CandidateSet.h"
+#include "Common.h"
+#include "GuessContext.h"
+#include "Strategy.h"
+#include "Symmetry.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+//! OptimalStrategy plays so that the average number of guesses over all secrets is the smallest possible
+/*!
+    MiniMax averages 4.476 guesses over all secrets of the classic game while the optimum is 5625 / 1296 = 4.340(Koyama and Lai).
+    This strategy finds the optimum with a depth first search of the game tree. Cost of a set of codes S is the total number of
+    guesses needed to find every code of S:
+        Cost(S) = |S| + minimum over guesses g of the sum of Cost(S_f) over the feedbacks f of g which are not winning
+    where S_f are the codes of S which give feedback f to g. Search is a branch and bound:
+    1 - LowerBound(n) is the cost of a perfect tree, in which every guess can win and splits the rest into every other feedback.
+        Guesses are tried in increasing order of |S| + sum of LowerBound(|S_f|), a node stops when that is not smaller than the best
+        cost found so far or when the best cost reaches LowerBound(|S|). Each subtree is searched with the budget left by the others.
+    2 - Only one guess of each symmetry class given the guesses on the path is tried(see Symmetry).
+    3 - Results are kept in the TranspositionTable keyed by S, exact costs with their guess or lower bounds of searches which
+        were cut by their budget. Same S is reached by many paths.
+    4 - Subtrees of the guess being tried at the first node are searched in parallel on ThreadPool::Instance(), threads take the
+        next subtree from a shared counter. It is not work stealing, only the root's partitions are shared and deeper nodes are
+        searched serially by the thread which took the subtree. Partitions are taken biggest first, but when one subtree costs far
+        more than the others the remaining threads wait for it, so the speedup is bounded by the biggest subtree of each guess.
+    Chosen guesses do not depend on the number of threads. Search of the classic game takes about half a minute on one core and
+    visits about 190000 nodes, it finds the optimum of 5625 guesses with at most 6 per secret. So a game which is played more
+    than once should build an OpeningBook from this strategy and save it. Length of the game is not limited by MaximumRoundCount.
+*/
+template <typename Config>
+class BasicOptimalStrategy final : public BasicIStrategy<Config>
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using GuessContext = BasicGuessContext<Config>;
+    using CandidateSet = BasicCandidateSet<Config>;
+
+    //! SearchStatistics counts the nodes, sets of codes, the search visited
+    struct SearchStatistics
+    {
+        long long nodeCount = 0;
+    };
+
+    virtual Code Guess( const GuessContext& context ) override
+    {
+        auto path = context.PastGuesses();
+        return Code::FromIndex(Solve(context.Candidates(), path, Unbounded, true).guessIndex);
+    }
+
+    //! Cost returns the total number of guesses optimal play needs to find every code of codes after pastGuesses
+    uint32_t Cost( const CandidateSet& codes, const std::vector<Code>& pastGuesses )
+    {
+        auto path = pastGuesses;
+        return Solve(codes, path, Unbounded, true).cost;
+    }
+
+    //! SetTranspositionTable changes the table results are kept in, it should not be nullptr
+    void SetTranspositionTable( TranspositionTable* transpositionTable )
+    {
+        this->transpositionTable = transpositionTable;
+    }
+
+    SearchStatistics GetStatistics() const
+    {
+        return SearchStatistics{ nodeCount.load(std::memory_order_relaxed) };
+    }
+
+    //! LowerBound is the cost of codeCount codes in a tree where each guess wins one code and every other feedback has a child
+    static uint32_t LowerBound( size_t codeCount )
+    {
+        const uint64_t childCount = Common::GetFeedbackCount<Config>() - 1;
+        uint64_t returnVal = 0;
+        uint64_t levelWidth = 1;
+        for ( uint64_t level = 1; codeCount > 0; level++ )
+        {
+            uint64_t wonCount = std::min<uint64_t>(codeCount, levelWidth);
+            returnVal += wonCount * level;
+            codeCount -= wonCount;
+            levelWidth *= childCount;
+        }
+        return static_cast<uint32_t>(returnVal);
+    }
+
+private:
+    static constexpr uint32_t Unbounded = std::numeric_limits<uint32_t>::max();
+
+    //! NodeResult is the cost of a set of codes with its best guess, or a lower bound of its cost when isExact is false
+    struct NodeResult
+    {
+        uint32_t cost;
+        int guessIndex;
+        bool isExact;
+    };
+
+    //! Partition is the codes which give the same feedback to a guess
+    struct Partition
+    {
+        CandidateSet codes;
+        uint32_t size;
+    };
+
+    //! Solve returns Cost(codes) with its guess when it is smaller than budget, otherwise a lower bound which is at least budget
+    NodeResult Solve( const CandidateSet& codes, std::vector<Code>& path, uint32_t budget, bool isParallel )
+    {
+        nodeCount.fetch_add(1, std::memory_order_relaxed);
+        const size_t codeCount = codes.Count();
+        if ( codeCount == 1 )
+            return NodeResult{ 1, static_cast<int>(codes.First()), true };
+
+        const auto key = TranspositionTable::MakeKey(static_cast<uint32_t>(Common::GameMode::Optimal), Config::LengthOfSecret(),
+                                                     Config::ColorCount(), codes.Words());
+        if ( auto cachedValue = transpositionTable->Find(key) )
+        {
+            auto cachedResult = Unpack(*cachedValue);
+            if ( cachedResult.isExact || cachedResult.cost >= budget )
+                return cachedResult;
+        }
+        const uint32_t lowerBound = LowerBound(codeCount);
+        if ( lowerBound >= budget )
+            return NodeResult{ lowerBound, -1, false };
+
+        NodeResult best{ budget, -1, false };
+        for ( const auto& [guessLowerBound, isNotCandidate, guessIndex] : GuessOrder(codes, path) )
+        {
+            if ( guessLowerBound >= best.cost )
+                break;
+            uint32_t cost = Evaluate(codes, Code::FromIndex(guessIndex), best.cost, path, isParallel);
+            if ( cost < best.cost )
+                best = NodeResult{ cost, guessIndex, true };
+            if ( best.cost == lowerBound )
+                break;
+        }
+        transpositionTable->Insert(key, Pack(best));
+        return best;
+    }
+
+    //! GuessOrder lists lower bound of the cost, whether it is not a candidate and index of every guess which splits codes
+    std::vector<std::tuple<uint32_t, bool, int>> GuessOrder( const CandidateSet& codes, const std::vector<Code>& path )
+    {
+        const size_t codeCount = codes.Count();
+        const BasicCandidateScorer<Config> scorer(codes);
+        std::vector<Common::FeedbackId> feedbacks(codeCount);
+        std::vector<std::tuple<uint32_t, bool, int>> returnVal;
+        for ( const auto& guess : BasicSymmetry<Config>(path).Representatives(AllCodes()) )
+        {
+            std::array<uint32_t, Common::MaxFeedbackCount<Config>> sizes{};
+            scorer.Score(guess, feedbacks);
+            for ( auto feedback : feedbacks )
+                sizes[feedback]++;
+            const bool isCandidate = codes.Contains(guess.GetIndex());
+            if ( !isCandidate && *std::max_element(sizes.begin(), sizes.end()) == codeCount )
+                continue;
+            uint32_t guessLowerBound = static_cast<uint32_t>(codeCount);
+            for ( int feedback = 0; feedback < Common::GetFeedbackCount<Config>(); feedback++ )
+            {
+                if ( feedback != Common::GetWinningFeedback<Config>() )
+                    guessLowerBound += LowerBound(sizes[feedback]);
+            }
+            returnVal.emplace_back(guessLowerBound, !isCandidate, guess.GetIndex());
+        }
+        std::ranges::sort(returnVal);
+        return returnVal;
+    }
+
+    //! Evaluate returns the cost of guessing guess for codes when it is smaller than bound, otherwise a number which is at least bound
+    uint32_t Evaluate( const CandidateSet& codes, const Code& guess, uint32_t bound, std::vector<Code>& path, bool isParallel )
+    {
+        std::vector<Partition> partitions = Split(codes, guess);
+        uint32_t total = static_cast<uint32_t>(codes.Count());
+        for ( const auto& partition : partitions )
+            total += LowerBound(partition.size);
+        if ( total >= bound )
+            return total;
+
+        path.push_back(guess);
+        if ( isParallel )
+        {
+            // Every subtree gets the budget left when all others cost their lower bound, so results do not depend on timing
+            std::vector<uint32_t> costs(partitions.size());
+            std::atomic<size_t> nextPartition = 0;
+            std::atomic<bool> isOverBound = false;
+            auto& threadPool = ThreadPool::Instance();
+            threadPool.ParallelFor(threadPool.GetThreadCount(), [&]( size_t, size_t, size_t ){
+                auto threadPath = path;
+                for ( size_t i = nextPartition++; i < partitions.size() && !isOverBound; i = nextPartition++ )
+                {
+                    const uint32_t partitionLowerBound = LowerBound(partitions[i].size);
+                    const uint32_t childBudget = bound - total + partitionLowerBound;
+                    costs[i] = Solve(partitions[i].codes, threadPath, childBudget, false).cost;
+                    if ( costs[i] >= childBudget )
+                        isOverBound = true;
+                }
+            });
+            path.pop_back();
+            if ( isOverBound )
+                return bound;
+            for ( size_t i = 0; i < partitions.size(); i++ )
+                total += costs[i] - LowerBound(partitions[i].size);
+            return total;
+        }
+
+        for ( const auto& partition : partitions )
+        {
+            const uint32_t partitionLowerBound = LowerBound(partition.size);
+            total += Solve(partition.codes, path, bound - total + partitionLowerBound, false).cost - partitionLowerBound;
+            if ( total >= bound )
+                break;
+        }
+        path.pop_back();
+        return total;
+    }
+
+    //! Split returns the codes which give each feedback other than winning to guess, biggest first
+    std::vector<Partition> Split( const CandidateSet& codes, const Code& guess ) const
+    {
+        std::vector<Common::FeedbackId> feedbacks(codes.Count());
+        BasicCandidateScorer<Config>(codes).Score(guess, feedbacks);
+        std::vector<Partition> partitionOfFeedback(Common::GetFeedbackCount<Config>(), Partition{ CandidateSet(), 0 });
+        size_t i = 0;
+        codes.ForEach([&]( size_t index ){
+            auto& partition = partitionOfFeedback[feedbacks[i++]];
+            partition.codes.Insert(index);
+            partition.size++;
+        });
+
+        std::vector<Partition> returnVal;
+        for ( int feedback = 0; feedback < Common::GetFeedbackCount<Config>(); feedback++ )
+        {
+            if ( feedback != Common::GetWinningFeedback<Config>() && partitionOfFeedback[feedback].size > 0 )
+                returnVal.push_back(std::move(partitionOfFeedback[feedback]));
+        }
+        std::ranges::stable_sort(returnVal, []( const Partition& lhs, const Partition& rhs ){
+            return lhs.size > rhs.size;
+        });
+        return returnVal;
+    }
+
+    //! Pack stores cost in the low 32 bits, isExact in bit 32 and guess index + 1 above it
+    static uint64_t Pack( const NodeResult& result )
+    {
+        return uint64_t{result.cost} | (uint64_t{result.isExact} << 32) | (static_cast<uint64_t>(result.guessIndex + 1) << 33);
+    }
+
+    static NodeResult Unpack( uint64_t value )
+    {
+        return NodeResult{ static_cast<uint32_t>(value), static_cast<int>(value >> 33) - 1, ((value >> 32) & 1) != 0 };
+    }
+
+    const std::vector<Code>& AllCodes()
+    {
+        std::call_once(allCodesFlag, [this](){
+            auto allCodesView = Common::AllCodesView<Config>();
+            allCodes.assign(allCodesView.begin(), allCodesView.end());
+        });
+        return allCodes;
+    }
+
+    TranspositionTable* transpositionTable = &TranspositionTable::Instance();
+    std::atomic<long long> nodeCount = 0;
+    std::once_flag allCodesFlag;
+    std::vector<Code> allCodes;
+};
+
+using OptimalStrategy = BasicOptimalStrategy<Common::ClassicConfig>;
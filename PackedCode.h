@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace Common
+{
+    //! PackedWord is the smallest unsigned integer which can hold Length pegs with 4 bits per peg
+    template <int Length>
+    using PackedWord = std::conditional_t<Length * 4 <= 16, uint16_t,
+                       std::conditional_t<Length * 4 <= 32, uint32_t, uint64_t>>;
+
+    //! BasicPackedCode is a code whose pegs are packed into a single integer
+    /*!
+        Each peg takes 4 bits(a nibble) so colors can be in range [0, 15] and there can be up to 15 pegs(so peg counts still fit in a nibble).
+        First peg is stored in the most significant nibble, that way comparing two packed codes numerically
+        gives the same order as NextCode iterates.
+        Scoring is done with SWAR(SIMD within a register) routines which process all pegs at once with a handful of ALU operations:
+        1 - BlackCount xors two codes and counts the nibbles which are zero.
+        2 - CountOfColor xors the code with the color repeated in every nibble and counts zero nibbles.
+        3 - MatchCount sums the minimum of color counts which gives blacks + whites.
+    */
+    template <typename Config>
+    struct BasicPackedCode
+    {
+        static_assert(Config::MaxLength > 0 && Config::MaxLength <= 15, "Packed code supports up to 15 pegs");
+        static_assert(Config::MaxColors > 0 && Config::MaxColors <= 15, "Packed code supports up to 15 colors");
+
+        using Word = PackedWord<Config::MaxLength>;
+        static constexpr int BitsPerPeg = 4;
+
+        //! LowBits has the lowest bit of every used nibble set, 0x1111 for 4 pegs
+        static constexpr Word LowBits()
+        {
+            Word returnVal = 0;
+            for ( int i = 0; i < Config::LengthOfSecret(); i++ )
+                returnVal = static_cast<Word>((returnVal << BitsPerPeg) | 1);
+            return returnVal;
+        }
+
+        static constexpr BasicPackedCode FromArray( const std::array<int,Config::MaxLength>& colorCodeList )
+        {
+            BasicPackedCode returnVal;
+            for ( int i = 0; i < Config::LengthOfSecret(); i++ )
+                returnVal.bits = static_cast<Word>((returnVal.bits << BitsPerPeg) | (colorCodeList[i] & 0xF));
+            return returnVal;
+        }
+
+        constexpr std::array<int,Config::MaxLength> ToArray() const
+        {
+            std::array<int,Config::MaxLength> returnVal{};
+            for ( int i = 0; i < Config::LengthOfSecret(); i++ )
+                returnVal[i] = GetPeg(i);
+            return returnVal;
+        }
+
+        constexpr int GetPeg( int position ) const
+        {
+            return (bits >> ((Config::LengthOfSecret() - 1 - position) * BitsPerPeg)) & 0xF;
+        }
+
+        constexpr bool operator==( const BasicPackedCode& rhs ) const = default;
+
+        Word bits = 0;
+    };
+
+    //! NonZeroNibbles returns a word with the lowest bit of every non zero nibble of x set
+    template <typename Word>
+    constexpr Word NonZeroNibbles( Word x, Word lowBits )
+    {
+        x = static_cast<Word>(x | (x >> 1));
+        x = static_cast<Word>(x | (x >> 2));
+        return static_cast<Word>(x & lowBits);
+    }
+
+    //! NibbleCount counts set bits of a word which only has lowest bits of nibbles set
+    /*!
+        Multiplying by LowBits sums all nibbles into the most significant used nibble. It is cheaper than popcount
+        when the cpu has no popcount instruction.
+    */
+    template <typename Config, typename Word>
+    constexpr int NibbleCount( Word lowNibbleBits, Word lowBits )
+    {
+        return static_cast<int>((static_cast<uint64_t>(lowNibbleBits) * lowBits >> ((Config::LengthOfSecret() - 1) * 4)) & 0xF);
+    }
+
+    template <typename Config>
+    constexpr int BlackCount( BasicPackedCode<Config> lhs, BasicPackedCode<Config> rhs )
+    {
+        using Packed = BasicPackedCode<Config>;
+        auto difference = static_cast<typename Packed::Word>(lhs.bits ^ rhs.bits);
+        return Config::LengthOfSecret() - NibbleCount<Config>(NonZeroNibbles(difference, Packed::LowBits()), Packed::LowBits());
+    }
+
+    template <typename Config>
+    constexpr int CountOfColor( BasicPackedCode<Config> code, int color )
+    {
+        using Packed = BasicPackedCode<Config>;
+        auto broadcastColor = static_cast<typename Packed::Word>(Packed::LowBits() * color);
+        auto difference = static_cast<typename Packed::Word>(code.bits ^ broadcastColor);
+        return Config::LengthOfSecret() - NibbleCount<Config>(NonZeroNibbles(difference, Packed::LowBits()), Packed::LowBits());
+    }
+
+    //! ColorHistogram extracts count of every color, index 0 is unused since colors start from 1
+    template <typename Config>
+    constexpr std::array<uint8_t, Config::MaxColors+1> ColorHistogram( BasicPackedCode<Config> code )
+    {
+        std::array<uint8_t, Config::MaxColors+1> returnVal{};
+        for ( int color = 1; color <= Config::ColorCount(); color++ )
+            returnVal[color] = static_cast<uint8_t>(CountOfColor(code, color));
+        return returnVal;
+    }
+
+    //! MatchCount is blacks + whites, the number of colors two codes have in common regardless of position
+    template <typename Config>
+    constexpr int MatchCount( BasicPackedCode<Config> lhs, BasicPackedCode<Config> rhs )
+    {
+        int returnVal = 0;
+        for ( int color = 1; color <= Config::ColorCount(); color++ )
+        {
+            int lhsCount = CountOfColor(lhs, color);
+            int rhsCount = CountOfColor(rhs, color);
+            returnVal += lhsCount < rhsCount ? lhsCount : rhsCount;
+        }
+        return returnVal;
+    }
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//! PartitionPolicy holds the criteria which compare guesses by how they split the codes which can still be the secret
+/*!
+    A policy reduces the partition sizes of a guess to one integer score, lower score is a better guess. CandidateScorer counts
+    candidates into their partitions one by one, starting from Initial() and calling Add(score, count) after a partition grew
+    to count. Policy is IsMonotone when Add never decreases the score, then scoring a guess can stop as soon as its score is
+    bigger than the best score found so far(see CandidateScorer::ScorePartitions).
+    A policy is constructed for every move with the number of candidates and the number of feedbacks of the game.
+*/
+namespace PartitionPolicy
+{
+    //! WorstCase is Knuth's criterion, size of the biggest partition
+    struct WorstCase
+    {
+        static constexpr bool IsMonotone = true;
+
+        WorstCase( size_t , int )
+        {
+        }
+
+        uint64_t Initial() const
+        {
+            return 0;
+        }
+
+        uint64_t Add( uint64_t score, int count ) const
+        {
+            return std::max<uint64_t>(score, count);
+        }
+    };
+
+    //! ExpectedSize is Irving's criterion, expected number of codes left after the feedback
+    /*!
+        It is sum(n_i * n_i) / N, so the score is sum(n_i * n_i). Partition growing to n adds n * n - (n - 1) * (n - 1) = 2n - 1.
+    */
+    struct ExpectedSize
+    {
+        static constexpr bool IsMonotone = true;
+
+        ExpectedSize( size_t , int )
+        {
+        }
+
+        uint64_t Initial() const
+        {
+            return 0;
+        }
+
+        uint64_t Add( uint64_t score, int count ) const
+        {
+            return score + 2 * static_cast<uint64_t>(count) - 1;
+        }
+    };
+
+    //! MostParts is Kooi's criterion, number of partitions which are not empty
+    /*!
+        Score is the number of empty partitions, it starts from the number of feedbacks and decreases when a partition gets
+        its first code, so it is not monotone.
+    */
+    struct MostParts
+    {
+        static constexpr bool IsMonotone = false;
+
+        MostParts( size_t , int feedbackCount ) : feedbackCount(feedbackCount)
+        {
+        }
+
+        uint64_t Initial() const
+        {
+            return static_cast<uint64_t>(feedbackCount);
+        }
+
+        uint64_t Add( uint64_t score, int count ) const
+        {
+            return count == 1 ? score - 1 : score;
+        }
+
+        int feedbackCount;
+    };
+
+    //! Entropy is the Shannon entropy of the feedback, log2(N) - sum(n_i * log2(n_i)) / N bits
+    /*!
+        Highest entropy is the smallest sum(n_i * log2(n_i)), which is the score. n * log2(n) is kept with FixedPointBits fraction bits
+        in a table indexed by n, Add reads the difference of two neighbours. Integer sums are exact so the score does not depend
+        on the order candidates are counted in.
+    */
+    struct Entropy
+    {
+        static constexpr bool IsMonotone = true;
+        static constexpr int FixedPointBits = 20;
+
+        Entropy( size_t candidateCount, int ) : increments(candidateCount + 1, 0)
+        {
+            uint64_t previous = 0;
+            for ( size_t n = 2; n <= candidateCount; n++ )
+            {
+                auto current = static_cast<uint64_t>(std::llround(std::ldexp(n * std::log2(static_cast<double>(n)), FixedPointBits)));
+                increments[n] = current - previous;
+                previous = current;
+            }
+        }
+
+        uint64_t Initial() const
+        {
+            return 0;
+        }
+
+        uint64_t Add( uint64_t score, int count ) const
+        {
+            return score + increments[count];
+        }
+
+        //! increments[n] is n * log2(n) - (n - 1) * log2(n - 1) in fixed point
+        std::vector<uint64_t> increments;
+    };
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "BatchScorer.h"
+#include "Common.h"
+#include "GuessContext.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <vector>
+
+//! PartitionSearch finds the guess of a guess pool whose partitions of the scored codes are best by Policy
+/*!
+    It is the search MiniMax, partition and sampled strategies share, they only differ in the codes they score against and in the
+    order of the guesses. Guesses are scored with CandidateScorer on ThreadPool::Instance(), threads take the next guess of the
+    order from a shared counter and share the bound:
+    1 - With pruning and a monotone policy it is a branch and bound search, scoring a guess stops once its score is bigger than
+        the best score found so far. Pruning is only done when a score is strictly bigger, so every guess which ties the best is
+        scored exactly.
+    2 - Best guess has the smallest score, then is a code which can still be the secret, then comes first in the guess pool. Every
+        slice finds its own minimum and they are reduced in slice order, so it is the same with any number of threads.
+    3 - shouldStop is asked before every guess but the first, when it is true the best of the scored guesses is returned.
+*/
+template <typename Config, typename Policy>
+class BasicPartitionSearch
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using GuessContext = BasicGuessContext<Config>;
+    using Scorer = BasicCandidateScorer<Config>;
+
+    //! Unscored is the score of a guess which was not scored, it is never the best guess
+    static constexpr uint64_t Unscored = std::numeric_limits<uint64_t>::max();
+
+    //! Result is the position of the best guess in the guess pool and the work done, isCut is true when shouldStop ended the search
+    struct Result
+    {
+        size_t bestIndex = 0;
+        bool isCut = false;
+        long long scoredGuessCount = 0;
+        long long scoredCandidateCount = 0;
+    };
+
+    //! Run scores guessPool[i] for every i of evaluationOrder against the codes of scorer, scores[i] gets it when scores is given
+    /*!
+        A pruned guess gets a score bigger than the best one instead of its exact score, guesses which are not scored keep theirs.
+    */
+    template <typename ShouldStop>
+    static Result Run( const GuessContext& context, const Scorer& scorer, const std::vector<Code>& guessPool, std::span<const size_t> evaluationOrder,
+                       bool isPruning, ShouldStop&& shouldStop, std::span<uint64_t> scores = {} )
+    {
+        const Policy policy(scorer.Size(), Common::GetFeedbackCount<Config>());
+        auto& threadPool = ThreadPool::Instance();
+        const size_t bufferSize = std::min(scorer.Size(), Scorer::ChunkSize);
+        auto buffers = context.FeedbackScratch(bufferSize * threadPool.GetThreadCount());
+        std::vector<GuessScore> sliceMinimums(threadPool.GetThreadCount(), GuessScore{ Unscored, true, 0 });
+        std::atomic<uint64_t> bound = Unscored;
+        std::atomic<size_t> nextPosition = 0;
+        std::atomic<bool> isCut = false;
+        std::atomic<long long> scoredGuessCount = 0;
+        std::atomic<long long> scoredCandidateCount = 0;
+        threadPool.ParallelFor(threadPool.GetThreadCount(), [&]( size_t sliceIndex, size_t, size_t ){
+            auto feedbacks = buffers.subspan(sliceIndex * bufferSize, bufferSize);
+            GuessScore minimum = sliceMinimums[sliceIndex];
+            long long localScoredGuessCount = 0;
+            long long localScoredCandidateCount = 0;
+            for ( size_t position = nextPosition++; position < evaluationOrder.size(); position = nextPosition++ )
+            {
+                if ( position > 0 && shouldStop() )
+                {
+                    isCut = true;
+                    break;
+                }
+                const size_t i = evaluationOrder[position];
+                uint64_t currentBound = isPruning ? bound.load(std::memory_order_relaxed) : Unscored;
+                const auto score = scorer.ScorePartitions(guessPool[i], policy, currentBound, feedbacks);
+                if ( !scores.empty() )
+                    scores[i] = score.score;
+                minimum = std::min(minimum, GuessScore{ score.score, !context.Candidates().Contains(guessPool[i].GetIndex()), i });
+                localScoredGuessCount++;
+                localScoredCandidateCount += static_cast<long long>(score.scoredCount);
+                while ( score.score < currentBound && !bound.compare_exchange_weak(currentBound, score.score) )
+                {
+                }
+            }
+            sliceMinimums[sliceIndex] = minimum;
+            scoredGuessCount += localScoredGuessCount;
+            scoredCandidateCount += localScoredCandidateCount;
+        });
+        return Result{ std::get<2>(*std::ranges::min_element(sliceMinimums)), isCut, scoredGuessCount, scoredCandidateCount };
+    }
+
+    //! Best returns the position of the best guess when the scores of the guesses of guessPool are already known
+    static size_t Best( const GuessContext& context, const std::vector<Code>& guessPool, std::span<const uint64_t> scores )
+    {
+        auto& threadPool = ThreadPool::Instance();
+        std::vector<GuessScore> sliceMinimums(threadPool.GetThreadCount(), GuessScore{ Unscored, true, 0 });
+        threadPool.ParallelFor(guessPool.size(), [&]( size_t sliceIndex, size_t begin, size_t end ){
+            GuessScore minimum = sliceMinimums[sliceIndex];
+            for ( size_t i = begin; i < end; i++ )
+                minimum = std::min(minimum, GuessScore{ scores[i], !context.Candidates().Contains(guessPool[i].GetIndex()), i });
+            sliceMinimums[sliceIndex] = minimum;
+        });
+        return std::get<2>(*std::ranges::min_element(sliceMinimums));
+    }
+
+private:
+    //! GuessScore orders guesses by score, then codes which can still be the secret, then position in the guess pool
+    using GuessScore = std::tuple<uint64_t, bool, size_t>;
+};
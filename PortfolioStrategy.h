@@ -0,0 +1,225 @@
+#pragma once
+
+#include "BatchScorer.h"
+#include "Common.h"
+#include "GuessContext.h"
+#include "PartitionPolicy.h"
+#include "SampledStrategy.h"
+#include "SearchLimit.h"
+#include "Strategy.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+//! PortfolioStrategy races several strategies for every guess and plays the best of their guesses
+/*!
+    Strategies are good at different numbers of candidates. MiniMax is exact but its cost grows with the candidates, the sampled
+    strategy costs the same for any number of them and Swaszek answers at once. For every move:
+    1 - Members search the move at the same time on ThreadPool::Instance(), one member per thread. Loops of a member run serially
+        on its thread, when there are more members than threads a thread searches its members one after another.
+    2 - Every member gets a SearchLimit at start + moveBudget(or the deadline of the limit the portfolio got, when it is sooner).
+        A guess which can still be the secret and splits the candidates into single codes can only be beaten by the same score of
+        an earlier member, when a member returns one the limits of the later members are cancelled and they return the best guess
+        they scored so far(see SetSearchLimit). Earlier members finish, so the winner is the one of a race without cancelling.
+    3 - Guesses of the members are scored against all candidates with Policy. Best score wins, then a code which can still be the
+        secret, then the first member. Winner of every round of the game is logged(see GetRoundWinners) and counted.
+    Guess does not depend on the number of threads unless the limit cut a search. Members only play enumerated games.
+*/
+template <typename Config, typename Policy = PartitionPolicy::ExpectedSize>
+class BasicPortfolioStrategy final : public BasicIStrategy<Config>
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using GuessContext = BasicGuessContext<Config>;
+    using Scorer = BasicCandidateScorer<Config>;
+
+    struct Member
+    {
+        std::string name;
+        std::shared_ptr<BasicIStrategy<Config>> strategy;
+    };
+
+    //! Statistics sum all raced moves, a cancelled move was settled by a guess which can not be beaten and a cut move by the deadline
+    struct Statistics
+    {
+        long long moveCount = 0;
+        long long cancelledMoveCount = 0;
+        long long cutMoveCount = 0;
+        //! winCounts[i] is the number of moves member i won, a move with one candidate left is not raced and the first member wins it
+        std::vector<long long> winCounts;
+    };
+
+    explicit BasicPortfolioStrategy( std::vector<Member> members, std::chrono::milliseconds moveBudget = std::chrono::milliseconds::max() )
+        : members(std::move(members)), moveBudget(moveBudget)
+    {
+        statistics.winCounts.assign(this->members.size(), 0);
+    }
+
+    //! DefaultMembers are MiniMax, entropy, sampled MiniMax and Swaszek which plays the first consistent code
+    static std::vector<Member> DefaultMembers()
+    {
+        return {
+            Member{ "MiniMax", std::make_shared<BasicMiniMaxStrategy<Config>>() },
+            Member{ "Entropy", std::make_shared<BasicEntropyStrategy<Config>>() },
+            Member{ "Sampled MiniMax", std::make_shared<BasicSampledMiniMaxStrategy<Config>>() },
+            Member{ "Swaszek", std::make_shared<BasicSwaszekStrategy<Config>>() },
+        };
+    }
+
+    //! SampledMembers are sampled MiniMax, sampled entropy and Swaszek, for games which are too big for exact searches
+    static std::vector<Member> SampledMembers()
+    {
+        return {
+            Member{ "Sampled MiniMax", std::make_shared<BasicSampledMiniMaxStrategy<Config>>() },
+            Member{ "Sampled Entropy", std::make_shared<BasicSampledStrategy<Config, PartitionPolicy::Entropy>>() },
+            Member{ "Swaszek", std::make_shared<BasicSwaszekStrategy<Config>>() },
+        };
+    }
+
+    virtual Code Guess( const GuessContext& context ) override
+    {
+        const auto& probableCodes = context.Candidates();
+        if ( probableCodes.Count() == 1 )
+        {
+            Win(0);
+            return Code::FromIndex(probableCodes.First());
+        }
+
+        const auto start = SearchLimit::Clock::now();
+        std::deque<SearchLimit> limits;
+        for ( size_t i = 0; i < members.size(); i++ )
+            limits.emplace_back(Deadline(start));
+        const Scorer scorer(probableCodes);
+        const Policy policy(scorer.Size(), Common::GetFeedbackCount<Config>());
+        const auto perfectScore = PerfectScore(policy, scorer.Size());
+        const size_t bufferSize = std::min(scorer.Size(), Scorer::ChunkSize);
+        context.GuessPool();
+
+        std::vector<std::optional<GuessScore>> scores(members.size());
+        std::vector<Code> guesses(members.size(), Code::FromIndex(0));
+        std::atomic<bool> isCancelled = false;
+        ThreadPool::Instance().ParallelFor(members.size(), [&]( size_t, size_t begin, size_t end ){
+            for ( size_t i = begin; i < end; i++ )
+            {
+                if ( i > begin && limits[i].ShouldStop() )
+                    continue;
+                members[i].strategy->SetSearchLimit(&limits[i]);
+                guesses[i] = members[i].strategy->Guess(context);
+                members[i].strategy->SetSearchLimit(nullptr);
+                const uint64_t score = scorer.ScorePartitions(guesses[i], policy, std::numeric_limits<uint64_t>::max(),
+                                                              context.FeedbackScratch(bufferSize)).score;
+                const bool isProbable = probableCodes.Contains(guesses[i].GetIndex());
+                scores[i] = GuessScore{ score, !isProbable, i };
+                if ( isProbable && score == perfectScore )
+                {
+                    isCancelled = true;
+                    for ( size_t j = i + 1; j < members.size(); j++ )
+                        limits[j].Cancel();
+                }
+            }
+        });
+
+        const size_t winner = std::get<2>(**std::min_element(scores.begin(), scores.end(), []( const auto& lhs, const auto& rhs ){
+            return lhs && (!rhs || *lhs < *rhs);
+        }));
+        const bool isCut = std::ranges::any_of(limits, &SearchLimit::IsCut);
+        statistics.moveCount++;
+        statistics.cancelledMoveCount += isCancelled ? 1 : 0;
+        statistics.cutMoveCount += !isCancelled && isCut ? 1 : 0;
+        if ( searchLimit && !isCancelled && isCut )
+            searchLimit->ShouldStop();
+        Win(winner);
+        return guesses[winner];
+    }
+
+    virtual void OnGameStart( const GuessContext& context ) override
+    {
+        roundWinners.clear();
+        for ( auto& member : members )
+            member.strategy->OnGameStart(context);
+    }
+
+    virtual void OnFeedback( const GuessContext& context, const BasicCandidateSet<Config>& eliminatedCodes ) override
+    {
+        for ( auto& member : members )
+            member.strategy->OnFeedback(context, eliminatedCodes);
+    }
+
+    virtual void OnGameEnd( const GuessContext& context, bool isWon ) override
+    {
+        for ( auto& member : members )
+            member.strategy->OnGameEnd(context, isWon);
+    }
+
+    //! SetSearchLimit makes the race stop at the deadline of searchLimit when it is sooner than the move budget
+    virtual void SetSearchLimit( const SearchLimit* searchLimit ) override
+    {
+        this->searchLimit = searchLimit;
+    }
+
+    const std::vector<Member>& GetMembers() const
+    {
+        return members;
+    }
+
+    //! GetRoundWinners lists the member whose guess was played in every round of the current game
+    const std::vector<size_t>& GetRoundWinners() const
+    {
+        return roundWinners;
+    }
+
+    const Statistics& GetStatistics() const
+    {
+        return statistics;
+    }
+
+private:
+    //! GuessScore orders guesses of the members by score, then codes which can still be the secret, then member order
+    using GuessScore = std::tuple<uint64_t, bool, size_t>;
+
+    //! PerfectScore is the score of a guess which splits candidateCount codes into single codes, if there are enough feedbacks
+    static std::optional<uint64_t> PerfectScore( const Policy& policy, size_t candidateCount )
+    {
+        if ( candidateCount > static_cast<size_t>(Common::GetFeedbackCount<Config>()) )
+            return std::nullopt;
+        uint64_t returnVal = policy.Initial();
+        for ( size_t i = 0; i < candidateCount; i++ )
+            returnVal = policy.Add(returnVal, 1);
+        return returnVal;
+    }
+
+    //! Deadline is start + moveBudget or the deadline of searchLimit if it is sooner, a budget of milliseconds::max() never stops
+    SearchLimit::Clock::time_point Deadline( SearchLimit::Clock::time_point start ) const
+    {
+        auto returnVal = SearchLimit::Clock::time_point::max();
+        if ( moveBudget < std::chrono::duration_cast<std::chrono::milliseconds>(returnVal - start) )
+            returnVal = start + moveBudget;
+        if ( searchLimit )
+            returnVal = std::min(returnVal, searchLimit->GetDeadline());
+        return returnVal;
+    }
+
+    void Win( size_t memberIndex )
+    {
+        statistics.winCounts[memberIndex]++;
+        roundWinners.push_back(memberIndex);
+    }
+
+    std::vector<Member> members;
+    std::chrono::milliseconds moveBudget;
+    const SearchLimit* searchLimit = nullptr;
+    std::vector<size_t> roundWinners;
+    Statistics statistics;
+};
+
+using PortfolioStrategy = BasicPortfolioStrategy<Common::ClassicConfig>;
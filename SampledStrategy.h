@@ -0,0 +1,136 @@
+#pragma once
+
+#include "BatchScorer.h"
+#include "Common.h"
+#include "GuessContext.h"
+#include "PartitionPolicy.h"
+#include "PartitionSearch.h"
+#include "Strategy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+//! SampledStrategy is PartitionStrategy which scores a random sample of the guesses against a random sample of the candidates
+/*!
+    Exact search scores every guess of the pool against every candidate, which is up to 10^11 scores for a move of 6 pegs 9 colors.
+    1 - When there are more candidates than the confidence bound asks for, guesses are scored against a uniform sample of them. By
+        Hoeffding's inequality the share of the sample in a partition is within tolerance of the share of all candidates with
+        probability confidence when the sample has ln(2 / (1 - confidence)) / (2 * tolerance^2) codes, 4612 for the defaults.
+        Score is the same Policy as the exact strategy on the sample, so SampledMiniMaxStrategy estimates the worst case of MiniMax.
+    2 - Guesses of the pool which are not guessed yet are scored by PartitionSearch in a random order until guessSampleSize
+        guesses are scored or the time budget of the move runs out, so the number of guesses adapts to the time. A SearchLimit stops
+        it the same way. Branch and bound and ties are the same as PartitionStrategy.
+    Random numbers are seeded from the history. When the time budget does not run out the guess only depends on the history, and
+    when all candidates fit in the sample and guessSampleSize covers the guess pool it is the guess of the exact strategy.
+*/
+template <typename Config, typename Policy>
+class BasicSampledStrategy final : public BasicIStrategy<Config>
+{
+public:
+    using Code = Common::BasicCode<Config>;
+    using GuessContext = BasicGuessContext<Config>;
+    using Scorer = BasicCandidateScorer<Config>;
+
+    struct Settings
+    {
+        double confidence = 0.95;
+        double tolerance = 0.02;
+        size_t guessSampleSize = std::numeric_limits<size_t>::max();
+        std::chrono::milliseconds timeBudget{ 1000 };
+        uint64_t seed = 0x243F6A8885A308D3;
+    };
+
+    //! SearchStatistics sums all moves which were searched, candidateSampleSize is the sample of the last move
+    struct SearchStatistics
+    {
+        long long moveCount = 0;
+        long long scoredGuessCount = 0;
+        size_t candidateSampleSize = 0;
+        double seconds = 0;
+    };
+
+    BasicSampledStrategy() : BasicSampledStrategy(Settings{})
+    {
+    }
+
+    explicit BasicSampledStrategy( const Settings& settings ) : settings(settings)
+    {
+    }
+
+    //! CandidateSampleSize is the number of candidates the confidence bound of the settings asks for
+    size_t CandidateSampleSize() const
+    {
+        return static_cast<size_t>(std::ceil(std::log(2 / (1 - settings.confidence)) / (2 * settings.tolerance * settings.tolerance)));
+    }
+
+    virtual Code Guess( const GuessContext& context ) override
+    {
+        const auto candidateIndexes = context.CandidateIndexes();
+        if ( candidateIndexes.size() == 1 )
+            return Code::FromIndex(candidateIndexes.front());
+
+        const auto start = std::chrono::steady_clock::now();
+        std::mt19937_64 random(context.HistorySeed(settings.seed));
+        std::vector<int> sampleIndexes;
+        std::sample(candidateIndexes.begin(), candidateIndexes.end(), std::back_inserter(sampleIndexes), CandidateSampleSize(), random);
+        std::vector<Code> sample;
+        sample.reserve(sampleIndexes.size());
+        for ( int index : sampleIndexes )
+            sample.push_back(Code::FromIndex(index));
+        const Scorer scorer(sample);
+
+        const auto& allCodes = context.GuessPool();
+        std::vector<size_t> evaluationOrder;
+        evaluationOrder.reserve(allCodes.size());
+        for ( size_t i = 0; i < allCodes.size(); i++ )
+        {
+            if ( !context.IsGuessed(allCodes[i].GetIndex()) )
+                evaluationOrder.push_back(i);
+        }
+        std::shuffle(evaluationOrder.begin(), evaluationOrder.end(), random);
+        evaluationOrder.resize(std::min(evaluationOrder.size(), settings.guessSampleSize));
+
+        const auto result = BasicPartitionSearch<Config, Policy>::Run(context, scorer, allCodes, evaluationOrder, true, [&](){
+            return IsOutOfTime(start) || (searchLimit && searchLimit->ShouldStop());
+        });
+
+        statistics.moveCount++;
+        statistics.scoredGuessCount += result.scoredGuessCount;
+        statistics.candidateSampleSize = sample.size();
+        statistics.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return allCodes[result.bestIndex];
+    }
+
+    virtual void SetSearchLimit( const SearchLimit* searchLimit ) override
+    {
+        this->searchLimit = searchLimit;
+    }
+
+    SearchStatistics GetStatistics() const
+    {
+        return statistics;
+    }
+
+private:
+    //! IsOutOfTime compares in milliseconds so that a time budget of milliseconds::max() does not overflow
+    bool IsOutOfTime( std::chrono::steady_clock::time_point start ) const
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start) >= settings.timeBudget;
+    }
+
+    Settings settings;
+    const SearchLimit* searchLimit = nullptr;
+    SearchStatistics statistics;
+};
+
+//! SampledMiniMaxStrategy estimates Knuth's worst case on samples, for games where MiniMaxStrategy is too slow
+template <typename Config>
+using BasicSampledMiniMaxStrategy = BasicSampledStrategy<Config, PartitionPolicy::WorstCase>;
+
+using SampledMiniMaxStrategy = BasicSampledMiniMaxStrategy<Common::ClassicConfig>;
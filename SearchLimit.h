@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+//! SearchLimit tells a search of a guess when to stop, at a deadline or when it is cancelled from another thread
+/*!
+    Strategies whose search can be interrupted check ShouldStop between the guesses they score and return the best guess scored
+    so far once it is true(see BasicIStrategy::SetSearchLimit). ShouldStop remembers that it stopped a search, so the caller can
+    count the moves which were cut. Deadline is checked with a steady clock, a default limit never stops.
+    Cancel and ShouldStop can be called from any thread, one limit can be shared by searches running at the same time.
+*/
+class SearchLimit
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SearchLimit() = default;
+
+    explicit SearchLimit( Clock::time_point deadline ) : deadline(deadline)
+    {
+    }
+
+    //! Cancel stops the searches at their next check, before the deadline
+    void Cancel()
+    {
+        isCancelled.store(true, std::memory_order_relaxed);
+    }
+
+    //! ShouldStop is true when the limit is cancelled or the deadline passed
+    bool ShouldStop() const
+    {
+        if ( !isCancelled.load(std::memory_order_relaxed) && Clock::now() < deadline )
+            return false;
+        isCut.store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    //! IsCut is true when ShouldStop stopped a search
+    bool IsCut() const
+    {
+        return isCut.load(std::memory_order_relaxed);
+    }
+
+    Clock::time_point GetDeadline() const
+    {
+        return deadline;
+    }
+
+private:
+    Clock::time_point deadline = Clock::time_point::max();
+    std::atomic<bool> isCancelled = false;
+    mutable std::atomic<bool> isCut = false;
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Common.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+//! Symmetry is the group of peg and color permutations which keep every past guess same
+/*!
+    Permuting the pegs and relabeling the colors of two codes the same way does not change their score. So when a permutation keeps
+    every past guess same, it also keeps the codes which can still be the secret same, and a guess and its image split them into
+    partitions of the same sizes. Strategies which search for the best guess only need one guess from each equivalence class.
+    Group is stored as:
+    1 - A list of mappings. Each is a peg permutation with the color relabeling it forces on colors which appear in past guesses.
+    2 - Any permutation of free colors, colors which never appeared in a past guess.
+    Representative of a class is its code with the smallest index. Before the first guess there are only 5 classes for the
+    classic game: 1111, 1112, 1122, 1123 and 1234.
+    Peg permutations are only searched up to MaximumPermutedLength pegs, longer codes are only reduced by free colors.
+*/
+template <typename Config>
+class BasicSymmetry
+{
+public:
+    using Code = Common::BasicCode<Config>;
+
+    static constexpr int MaximumPermutedLength = 8;
+
+    explicit BasicSymmetry( const std::vector<Code>& pastGuesses )
+    {
+        std::vector<typename Code::CodeArray> guesses;
+        for ( const auto& pastGuess : pastGuesses )
+        {
+            guesses.push_back(pastGuess.GetCode());
+            for ( int i = 0; i < Config::LengthOfSecret(); i++ )
+                isUsedColor[guesses.back()[i]] = true;
+        }
+        for ( int color = 1; color <= Config::ColorCount(); color++ )
+        {
+            if ( !isUsedColor[color] )
+                freeColors[freeColorCount++] = static_cast<int8_t>(color);
+        }
+
+        Mapping mapping;
+        std::iota(mapping.positions.begin(), mapping.positions.begin() + Config::LengthOfSecret(), 0);
+        if ( Config::LengthOfSecret() > MaximumPermutedLength )
+        {
+            std::iota(mapping.colors.begin(), mapping.colors.end(), 0);
+            mappings.push_back(mapping);
+            return;
+        }
+        // Identity is the first permutation so most codes which are not representatives are rejected by the first mapping
+        do
+        {
+            if ( ForceColors(guesses, mapping) )
+                mappings.push_back(mapping);
+        } while ( std::next_permutation(mapping.positions.begin(), mapping.positions.begin() + Config::LengthOfSecret()) );
+    }
+
+    //! IsTrivial is true when the group has no element other than identity, so every code is its own class
+    bool IsTrivial() const
+    {
+        return mappings.size() == 1 && freeColorCount <= 1;
+    }
+
+    //! IsRepresentative is true when no element of the group maps code to a code with a smaller index
+    bool IsRepresentative( const Code& code ) const
+    {
+        const auto colorCodeList = code.GetCode();
+        for ( const auto& mapping : mappings )
+        {
+            std::array<int8_t, Config::MaxColors + 1> freeColorLabels{};
+            int nextFreeColor = 0;
+            for ( int i = 0; i < Config::LengthOfSecret(); i++ )
+            {
+                int color = colorCodeList[mapping.positions[i]];
+                int image = mapping.colors[color];
+                if ( !isUsedColor[color] )
+                {
+                    if ( freeColorLabels[color] == 0 )
+                        freeColorLabels[color] = freeColors[nextFreeColor++];
+                    image = freeColorLabels[color];
+                }
+                if ( image < colorCodeList[i] )
+                    return false;
+                if ( image > colorCodeList[i] )
+                    break;
+            }
+        }
+        return true;
+    }
+
+    //! Representatives returns the representative codes of allCodes in the same order
+    /*!
+        allCodes should be all codes of the configuration, otherwise it is returned as is since a class may not have its
+        representative in it.
+    */
+    std::vector<Code> Representatives( const std::vector<Code>& allCodes ) const
+    {
+        if ( IsTrivial() || allCodes.size() != static_cast<size_t>(Common::GetCodeCount<Config>()) )
+            return allCodes;
+        std::vector<Code> returnVal;
+        std::ranges::copy_if(allCodes, std::back_inserter(returnVal), [this]( const Code& code ){
+            return IsRepresentative(code);
+        });
+        return returnVal;
+    }
+
+private:
+    //! Mapping sends the peg at positions[i] to position i and relabels color c as colors[c], colors of free colors are unused
+    struct Mapping
+    {
+        std::array<int8_t, Config::MaxLength> positions{};
+        std::array<int8_t, Config::MaxColors + 1> colors{};
+    };
+
+    //! ForceColors finds the color relabeling which keeps every guess same under the peg permutation, false if there is none
+    bool ForceColors( const std::vector<typename Code::CodeArray>& guesses, Mapping& mapping ) const
+    {
+        mapping.colors.fill(0);
+        std::array<bool, Config::MaxColors + 1> isImage{};
+        for ( const auto& guess : guesses )
+        {
+            for ( int i = 0; i < Config::LengthOfSecret(); i++ )
+            {
+                int color = guess[mapping.positions[i]];
+                if ( mapping.colors[color] == 0 )
+                {
+                    if ( isImage[guess[i]] )
+                        return false;
+                    mapping.colors[color] = static_cast<int8_t>(guess[i]);
+                    isImage[guess[i]] = true;
+                }
+                else if ( mapping.colors[color] != guess[i] )
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<Mapping> mappings;
+    std::array<bool, Config::MaxColors + 1> isUsedColor{};
+    std::array<int8_t, Config::MaxColors> freeColors{};
+    int freeColorCount = 0;
+};
+
+using Symmetry = BasicSymmetry<Common::ClassicConfig>;
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! ThreadPool runs a loop over a range on a fixed number of threads
+/*!
+    The range is split into one contiguous slice per thread, slice w is [w * count / n, (w + 1) * count / n). Calling thread
+    runs the first slice itself so a pool of n threads has n - 1 workers. Slices only depend on count and thread count, so
+    a function which writes each slice into its own buffer and merges the buffers in slice order gives the same result
+    with any number of threads.
+    Loops started from inside a loop, by a worker or by the thread which started it, or while another loop is running on another
+    thread run serially on the calling thread. A thread checks that it is inside a loop before it tries the loop mutex, so it never
+    locks a mutex it already holds.
+    Process wide pool is Instance(), its size is set with SetThreadCount and defaults to the number of hardware threads.
+*/
+class ThreadPool
+{
+public:
+    explicit ThreadPool( int threadCount ) : threadCount(std::max(threadCount, 1))
+    {
+        for ( int workerIndex = 1; workerIndex < this->threadCount; workerIndex++ )
+            workers.emplace_back([this, workerIndex](){
+                WorkerLoop(workerIndex);
+            });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock(mutex);
+            isStopping = true;
+        }
+        jobReady.notify_all();
+        for ( auto& worker : workers )
+            worker.join();
+    }
+
+    ThreadPool( const ThreadPool& ) = delete;
+    ThreadPool& operator=( const ThreadPool& ) = delete;
+
+    int GetThreadCount() const
+    {
+        return threadCount;
+    }
+
+    //! ParallelFor calls function(sliceIndex, begin, end) once per slice of [0, count) and returns when all slices are done
+    template <typename Function>
+    void ParallelFor( size_t count, Function&& function )
+    {
+        if ( threadCount == 1 || isInsideLoop )
+        {
+            function(size_t{0}, size_t{0}, count);
+            return;
+        }
+        std::unique_lock loopLock(loopMutex, std::try_to_lock);
+        if ( !loopLock.owns_lock() )
+        {
+            function(size_t{0}, size_t{0}, count);
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            job = [&function, count, this]( int sliceIndex ){
+                function(static_cast<size_t>(sliceIndex), SliceBegin(count, sliceIndex), SliceBegin(count, sliceIndex + 1));
+            };
+            remainingWorkerCount = threadCount - 1;
+            generation++;
+        }
+        jobReady.notify_all();
+
+        isInsideLoop = true;
+        job(0);
+        isInsideLoop = false;
+
+        std::unique_lock lock(mutex);
+        jobDone.wait(lock, [this](){
+            return remainingWorkerCount == 0;
+        });
+        job = nullptr;
+    }
+
+    static ThreadPool& Instance()
+    {
+        return *InstancePointer();
+    }
+
+    //! SetThreadCount replaces the process wide pool, it should not be called while the pool is in use
+    static void SetThreadCount( int threadCount )
+    {
+        InstancePointer() = std::make_unique<ThreadPool>(threadCount);
+    }
+
+    static int DefaultThreadCount()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+private:
+    size_t SliceBegin( size_t count, int sliceIndex ) const
+    {
+        return count * sliceIndex / threadCount;
+    }
+
+    void WorkerLoop( int workerIndex )
+    {
+        isInsideLoop = true;
+        size_t lastGeneration = 0;
+        while ( true )
+        {
+            std::function<void(int)>* currentJob = nullptr;
+            {
+                std::unique_lock lock(mutex);
+                jobReady.wait(lock, [this, lastGeneration](){
+                    return isStopping || generation != lastGeneration;
+                });
+                if ( isStopping )
+                    return;
+                lastGeneration = generation;
+                currentJob = &job;
+            }
+
+            (*currentJob)(workerIndex);
+
+            std::lock_guard lock(mutex);
+            if ( --remainingWorkerCount == 0 )
+                jobDone.notify_one();
+        }
+    }
+
+    static std::unique_ptr<ThreadPool>& InstancePointer()
+    {
+        static std::unique_ptr<ThreadPool> instance = std::make_unique<ThreadPool>(DefaultThreadCount());
+        return instance;
+    }
+
+    //! isInsideLoop is true on workers and on the thread which started a loop while it runs its slice
+    static inline thread_local bool isInsideLoop = false;
+
+    int threadCount;
+    std::vector<std::thread> workers;
+    std::mutex loopMutex;
+    std::mutex mutex;
+    std::condition_variable jobReady;
+    std::condition_variable jobDone;
+    std::function<void(int)> job;
+    size_t generation = 0;
+    int remainingWorkerCount = 0;
+    bool isStopping = false;
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Common.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+//! TranspositionTable remembers the guess a strategy chose for a set of candidate codes
+/*!
+    Different histories often leave the same codes which can still be the secret, and a deterministic strategy like MiniMax then
+    chooses the same guess. Results are keyed by a 128 bit fingerprint of the candidate set together with the strategy and size of
+    the game, so one process wide table(Instance) is shared by all games and configurations.
+    Memory is bounded, the table has a fixed number of entries split into shards. When a shard is full an entry is evicted with the
+    clock algorithm: entries which were used since the clock hand passed them get a second chance.
+    Each shard has its own lock so threads of a simulation rarely wait for each other. It counts hits and misses.
+*/
+class TranspositionTable
+{
+public:
+    static constexpr size_t DefaultCapacity = 1 << 16;
+    static constexpr size_t ShardCount = 16;
+
+    struct Key
+    {
+        uint64_t high = 0;
+        uint64_t low = 0;
+
+        bool operator==( const Key& rhs ) const = default;
+    };
+
+    //! MakeKey fingerprints the words of a CandidateSet, strategyId should be different for strategies which can choose differently
+    /*!
+        A strategy whose choice also depends on the guesses it searched gives the words of that set as guessPoolWords.
+    */
+    static Key MakeKey( uint32_t strategyId, int lengthOfSecret, int colorCount, std::span<const uint64_t> candidateWords,
+                        std::span<const uint64_t> guessPoolWords = {} )
+    {
+        Key returnVal{ 0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL };
+        auto add = [&returnVal]( uint64_t word ) {
+            returnVal.high = Common::Mix64(returnVal.high ^ word);
+            returnVal.low = Common::Mix64(returnVal.low + word * 0x9e3779b97f4a7c15ULL) ^ (returnVal.high >> 17);
+        };
+        add((uint64_t{strategyId} << 32) | (static_cast<uint64_t>(lengthOfSecret) << 16) | static_cast<uint64_t>(colorCount));
+        for ( auto word : candidateWords )
+            add(word);
+        add(guessPoolWords.size());
+        for ( auto word : guessPoolWords )
+            add(word);
+        return returnVal;
+    }
+
+    explicit TranspositionTable( size_t capacity = DefaultCapacity )
+    {
+        for ( auto& shard : shards )
+            shard.entries.resize(std::max<size_t>(capacity / ShardCount, 1));
+    }
+
+    std::optional<uint64_t> Find( const Key& key )
+    {
+        auto& shard = GetShard(key);
+        std::lock_guard lock(shard.mutex);
+        auto itr = shard.slots.find(key);
+        if ( itr == shard.slots.end() )
+        {
+            missCount.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+        auto& entry = shard.entries[itr->second];
+        entry.isReferenced = true;
+        return entry.value;
+    }
+
+    void Insert( const Key& key, uint64_t value )
+    {
+        auto& shard = GetShard(key);
+        std::lock_guard lock(shard.mutex);
+        if ( auto itr = shard.slots.find(key); itr != shard.slots.end() )
+        {
+            shard.entries[itr->second].value = value;
+            return;
+        }
+
+        while ( shard.entries[shard.clockHand].isOccupied && shard.entries[shard.clockHand].isReferenced )
+        {
+            shard.entries[shard.clockHand].isReferenced = false;
+            shard.clockHand = (shard.clockHand + 1) % shard.entries.size();
+        }
+        auto& entry = shard.entries[shard.clockHand];
+        if ( entry.isOccupied )
+            shard.slots.erase(entry.key);
+        entry = Entry{ key, value, true, false };
+        shard.slots[key] = shard.clockHand;
+        shard.clockHand = (shard.clockHand + 1) % shard.entries.size();
+    }
+
+    void Clear()
+    {
+        for ( auto& shard : shards )
+        {
+            std::lock_guard lock(shard.mutex);
+            std::fill(shard.entries.begin(), shard.entries.end(), Entry{});
+            shard.slots.clear();
+            shard.clockHand = 0;
+        }
+        hitCount = 0;
+        missCount = 0;
+    }
+
+    uint64_t GetHitCount() const
+    {
+        return hitCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetMissCount() const
+    {
+        return missCount.load(std::memory_order_relaxed);
+    }
+
+    static TranspositionTable& Instance()
+    {
+        static TranspositionTable table;
+        return table;
+    }
+
+private:
+    struct KeyHash
+    {
+        size_t operator()( const Key& key ) const
+        {
+            return static_cast<size_t>(key.low);
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        uint64_t value = 0;
+        bool isOccupied = false;
+        bool isReferenced = false;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::vector<Entry> entries;
+        std::unordered_map<Key, size_t, KeyHash> slots;
+        size_t clockHand = 0;
+    };
+
+    Shard& GetShard( const Key& key )
+    {
+        return shards[key.high % ShardCount];
+    }
+
+    std::array<Shard, ShardCount> shards;
+    std::atomic<uint64_t> hitCount = 0;
+    std::atomic<uint64_t> missCount = 0;
+};
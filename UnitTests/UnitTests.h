@@ -2,7 +2,81 @@
 
 #include "doctest.h"
 #include "../Common.h"
+#include "../Engines.h"
 #include "../Game.h"
+#include "../OpeningBook.h"
+
+#include <cstdio>
+#include <functional>
+#include <map>
+
+//! ThreadCountGuard sets the thread count of ThreadPool::Instance() and restores the default one when it goes out of scope
+class ThreadCountGuard
+{
+public:
+    explicit ThreadCountGuard( int threadCount )
+    {
+        ThreadPool::SetThreadCount(threadCount);
+    }
+
+    ThreadCountGuard( const ThreadCountGuard& ) = delete;
+    ThreadCountGuard& operator=( const ThreadCountGuard& ) = delete;
+
+    ~ThreadCountGuard()
+    {
+        ThreadPool::SetThreadCount(ThreadPool::DefaultThreadCount());
+    }
+};
+
+//! ComparedGames sums the games of CompareGames, guesses are the ones played in every game one after another
+struct ComparedGames
+{
+    std::vector<Common::Code> guesses;
+    int mismatchCount = 0;
+    int gameCount = 0;
+    int lostCount = 0;
+    int totalWinTurnCount = 0;
+    int maximumWinTurnCount = 0;
+};
+
+//! CompareGames plays every secretStep'th code of codes with strategy and counts the moves in which expectedStrategy guesses otherwise
+/*!
+    Expected code breaker gets the same feedbacks, so both guess from the same history. prepare can change how the code
+    breakers start a game, it is called after SetAllCodes. onFeedback is called after every feedback which does not win.
+*/
+inline ComparedGames CompareGames( std::shared_ptr<IStrategy> strategy, std::shared_ptr<IStrategy> expectedStrategy,
+                                   const std::vector<Common::Code>& codes, size_t secretStep,
+                                   const std::function<void( CodeBreaker&, CodeBreaker& )>& prepare = {},
+                                   const std::function<void( const CodeBreaker&, const CodeBreaker& )>& onFeedback = {} )
+{
+    ComparedGames returnVal;
+    for ( size_t secretIndex = 0; secretIndex < codes.size(); secretIndex += secretStep, returnVal.gameCount++ )
+    {
+        CodeBreaker codeBreaker( strategy );
+        CodeBreaker expectedCodeBreaker( expectedStrategy );
+        codeBreaker.SetAllCodes(codes);
+        expectedCodeBreaker.SetAllCodes(codes);
+        if ( prepare )
+            prepare(codeBreaker, expectedCodeBreaker);
+        int winTurnCount = 0;
+        for ( int i = 0; i < MaximumRoundCount && winTurnCount == 0; i++ )
+        {
+            returnVal.guesses.push_back(codeBreaker.Guess());
+            returnVal.mismatchCount += !(expectedCodeBreaker.Guess() == returnVal.guesses.back());
+            auto feedback = returnVal.guesses.back().Compare(codes[secretIndex]).ToFeedbackId();
+            codeBreaker.SetResult(feedback);
+            expectedCodeBreaker.SetResult(feedback);
+            if ( feedback == Common::WinningFeedback )
+                winTurnCount = i + 1;
+            else if ( onFeedback )
+                onFeedback(codeBreaker, expectedCodeBreaker);
+        }
+        returnVal.lostCount += winTurnCount == 0;
+        returnVal.totalWinTurnCount += winTurnCount;
+        returnVal.maximumWinTurnCount = std::max(returnVal.maximumWinTurnCount, winTurnCount);
+    }
+    return returnVal;
+}
 
 TEST_CASE("Testing random code(secret) generation") {
     Common::Code code;
@@ -36,6 +110,35 @@ TEST_CASE("Testing comparison between two codes") {
     CHECK(result.whiteCount == 2);
 }
 
+TEST_CASE("Testing histogram and SWAR compare kernels agree with reference compare") {
+    int mismatchCount = 0;
+    for ( int lhsIndex = 0; lhsIndex < Common::GetCodeCount(); lhsIndex++ )
+    {
+        auto lhs = Common::Code::FromIndex(lhsIndex);
+        for ( int rhsIndex = 0; rhsIndex < Common::GetCodeCount(); rhsIndex += 5 )
+        {
+            auto rhs = Common::Code::FromIndex(rhsIndex);
+            auto reference = Common::ReferenceCompare<LengthOfSecret>(lhs.GetCode(), rhs.GetCode());
+            if ( !(Common::CompareCodes<LengthOfSecret, ColorCount>(lhs.GetCode(), rhs.GetCode()) == reference) )
+                mismatchCount++;
+            if ( !(lhs.Compare(rhs) == reference) )
+                mismatchCount++;
+        }
+    }
+    CHECK(mismatchCount == 0);
+}
+
+TEST_CASE("Testing packed code representation") {
+    CHECK(sizeof(Common::Code) * 8 == sizeof(std::array<int,LengthOfSecret>));
+
+    Common::Code code( {4,4,2,1} );
+    CHECK(code.GetPacked().bits == 0x4421);
+    CHECK(code.GetCode() == std::array<int,LengthOfSecret>{4,4,2,1});
+    CHECK(Common::ColorHistogram(code.GetPacked())[4] == 2);
+    CHECK(Common::BlackCount(code.GetPacked(), Common::Code(4221).GetPacked()) == 3);
+    CHECK(Common::MatchCount(code.GetPacked(), Common::Code(1234).GetPacked()) == 3);
+}
+
 TEST_CASE("Testing integer ctor of Code") {
     Common::Code code( 1234 );
     Common::Code codeRhs( {1,2,3,4 });
@@ -76,6 +179,26 @@ TEST_CASE("Testing if we generated all outcomes correctly") {
     CHECK(allPossibleCodes.size() == 1296);//Wikipedia says there should be 1296
 }
 
+TEST_CASE("Testing ranking and unranking codes in code space") {
+    CHECK(Common::CodeSpace::Size() == 1296);
+    CHECK(Common::CodeSpace::Rank(Common::Code(1111).GetPacked()) == 0);
+    CHECK(Common::CodeSpace::Rank(Common::Code(1123).GetPacked()) == 8);
+    CHECK(Common::CodeSpace::Rank(Common::Code(6666).GetPacked()) == 1295);
+    CHECK(Common::Code(Common::CodeSpace::Unrank(8)) == Common::Code(1123));
+
+    auto allCodesView = Common::AllCodesView();
+    static_assert(std::ranges::random_access_range<decltype(allCodesView)>);
+    CHECK(std::ranges::size(allCodesView) == 1296);
+    CHECK(allCodesView[1295] == Common::Code(6666));
+
+    Common::Code code( 1111 );
+    for ( int i = 0; i < 100; i++ )
+    {
+        CHECK(allCodesView[i] == code);
+        code = Common::Code(code.NextCode());
+    }
+}
+
 TEST_CASE("Testing if elimination step is correct") {
     CodeBreaker codeBreaker( std::make_shared<UnitTestStrategy>(Common::Code(5566)) );
     Common::Code code1( 6666 );
@@ -88,12 +211,356 @@ TEST_CASE("Testing if elimination step is correct") {
     CHECK(countOfLeftOverElems == 2);
 }
 
+TEST_CASE("Testing guess context and strategy callbacks") {
+    struct RecordingStrategy final : public IStrategy
+    {
+        virtual Common::Code Guess( const GuessContext& context ) override
+        {
+            return Common::Code::FromIndex(context.Candidates().First());
+        }
+        virtual void OnGameStart( const GuessContext& context ) override
+        {
+            startCount++;
+            CHECK(context.PastGuesses().empty());
+        }
+        virtual void OnFeedback( const GuessContext& context, const CandidateSet& eliminatedCodes ) override
+        {
+            feedbackCount++;
+            eliminatedCount += eliminatedCodes.Count();
+            CHECK(context.PastFeedbacks().size() == context.PastGuesses().size());
+            CHECK(context.CandidateIndexes().size() == context.Candidates().Count());
+        }
+        virtual void OnGameEnd( const GuessContext&, bool isWon ) override
+        {
+            endCount++;
+            wasWon = isWon;
+        }
+        int startCount = 0;
+        int feedbackCount = 0;
+        size_t eliminatedCount = 0;
+        int endCount = 0;
+        bool wasWon = false;
+    };
+
+    auto allCodesView = Common::AllCodesView();
+    std::vector<Common::Code> allCodes(allCodesView.begin(), allCodesView.end());
+    auto strategy = std::make_shared<RecordingStrategy>();
+    CodeBreaker codeBreaker( strategy );
+    codeBreaker.SetAllCodes(allCodes);
+    CHECK(codeBreaker.GetContext().GuessPool().size() == 5);
+    Common::Code secret( 3456 );
+    int guessCount = 0;
+    while ( true )
+    {
+        auto guess = codeBreaker.Guess();
+        guessCount++;
+        CHECK(codeBreaker.GetContext().IsGuessed(guess.GetIndex()));
+        if ( codeBreaker.SetResult(guess.Compare(secret)) == 1 && guess == secret )
+            break;
+    }
+    const auto& context = codeBreaker.GetContext();
+    CHECK(strategy->startCount == 1);
+    CHECK(strategy->feedbackCount == guessCount);
+    CHECK(strategy->eliminatedCount == allCodes.size() - 1);
+    CHECK(strategy->endCount == 1);
+    CHECK(strategy->wasWon);
+    CHECK(context.PastGuesses().back() == secret);
+    CHECK(context.GetFeedbackMatrix() != nullptr);
+}
+
+TEST_CASE("Testing candidate sets and partition masks") {
+    auto allCodes = CandidateSet::All();
+    CHECK(CandidateSet::WordCount() == 21);
+    CHECK(allCodes.Count() == 1296);
+    CHECK(allCodes.First() == 0);
+
+    CandidateSet codes( { Common::Code(6666), Common::Code(1123), Common::Code(2111) } );
+    CHECK(codes.Count() == 3);
+    CHECK(codes.Contains(Common::Code(1123).GetIndex()));
+    CHECK_FALSE(codes.Contains(Common::Code(1122).GetIndex()));
+    std::vector<Common::Code> visitedCodes = codes.ToCodes();
+    CHECK(visitedCodes == std::vector<Common::Code>{ Common::Code(1123), Common::Code(2111), Common::Code(6666) });
+    codes.Erase(Common::Code(1123).GetIndex());
+    CHECK(codes.First() == static_cast<size_t>(Common::Code(2111).GetIndex()));
+
+    Common::Code guess( 1122 );
+    size_t totalCount = 0;
+    int mismatchCount = 0;
+    for ( int feedback = 0; feedback < Common::FeedbackCount; feedback++ )
+    {
+        auto partition = allCodes;
+        partition.IntersectWith(PartitionMasks::Instance().Mask(guess.GetIndex(), feedback));
+        totalCount += partition.Count();
+        partition.ForEach([&]( size_t index ){
+            mismatchCount += guess.Compare(Common::Code::FromIndex(index)).ToFeedbackId() != feedback;
+        });
+    }
+    CHECK(totalCount == 1296);
+    CHECK(mismatchCount == 0);
+}
+
+TEST_CASE("Testing feedback matrix agrees with Compare") {
+    const auto& feedbackMatrix = FeedbackMatrix::Instance();
+    CHECK(feedbackMatrix.GetCodeCount() == 1296);
+    int mismatchCount = 0;
+    for ( int guessIndex = 0; guessIndex < feedbackMatrix.GetCodeCount(); guessIndex += 7 )
+    {
+        auto guess = Common::Code::FromIndex(guessIndex);
+        CHECK(guess.GetIndex() == guessIndex);
+        for ( int candidateIndex = 0; candidateIndex < feedbackMatrix.GetCodeCount(); candidateIndex++ )
+        {
+            auto candidate = Common::Code::FromIndex(candidateIndex);
+            if ( feedbackMatrix.Get(guessIndex, candidateIndex) != guess.Compare(candidate).ToFeedbackId() )
+                mismatchCount++;
+        }
+    }
+    CHECK(mismatchCount == 0);
+}
+
+TEST_CASE("Testing dense feedback ids") {
+    CHECK(Common::FeedbackCount == 14);
+    std::vector<bool> isUsed(Common::FeedbackCount, false);
+    for ( int blackCount = 0; blackCount <= LengthOfSecret; blackCount++ )
+        for ( int whiteCount = 0; blackCount + whiteCount <= LengthOfSecret; whiteCount++ )
+        {
+            if ( blackCount == LengthOfSecret - 1 && whiteCount == 1 )
+                continue;
+            Common::Result result{ blackCount, whiteCount };
+            auto id = result.ToFeedbackId();
+            REQUIRE(id < Common::FeedbackCount);
+            CHECK(!isUsed[id]);
+            isUsed[id] = true;
+            CHECK(Common::Result::FromFeedbackId(id) == result);
+        }
+    CHECK(Common::Result{LengthOfSecret, 0}.ToFeedbackId() == Common::WinningFeedback);
+}
+
+TEST_CASE("Testing batch scorer kernels agree with feedback matrix") {
+    std::vector<Common::PackedCode> candidates;
+    for ( int i = 0; i < Common::GetCodeCount(); i += 3 )
+        candidates.push_back(Common::Code::FromIndex(i).GetPacked());
+    Common::CandidateLanes lanes(candidates);
+
+    std::vector<Common::FeedbackId> scalarFeedbacks(candidates.size());
+    std::vector<Common::FeedbackId> dispatchedFeedbacks(candidates.size());
+    std::vector<Common::FeedbackId> spanFeedbacks(candidates.size());
+    int mismatchCount = 0;
+    for ( int guessIndex = 0; guessIndex < Common::GetCodeCount(); guessIndex += 11 )
+    {
+        auto guess = Common::Code::FromIndex(guessIndex);
+        Common::ScoreLanesScalar(guess.GetPacked(), lanes.Pointers(), lanes.Size(), std::span(scalarFeedbacks));
+        Common::ScoreAgainst(guess.GetPacked(), lanes, std::span(dispatchedFeedbacks));
+        Common::ScoreAgainst(guess.GetPacked(), std::span<const Common::PackedCode>(candidates), std::span(spanFeedbacks));
+        for ( size_t i = 0; i < candidates.size(); i++ )
+        {
+            auto expected = FeedbackMatrix::Instance().Get(guess, Common::Code(candidates[i]));
+            if ( scalarFeedbacks[i] != expected || dispatchedFeedbacks[i] != expected || spanFeedbacks[i] != expected )
+                mismatchCount++;
+        }
+    }
+    CHECK(mismatchCount == 0);
+}
+
+TEST_CASE("Testing thread pool and multithreaded MiniMax") {
+    ThreadPool threadPool( 3 );
+    std::vector<int> visitCounts(100, 0);
+    std::vector<size_t> sliceSizes(threadPool.GetThreadCount(), 0);
+    threadPool.ParallelFor(visitCounts.size(), [&]( size_t sliceIndex, size_t begin, size_t end ){
+        for ( size_t i = begin; i < end; i++ )
+            visitCounts[i]++;
+        sliceSizes[sliceIndex] = end - begin;
+    });
+    CHECK(std::ranges::count(visitCounts, 1) == 100);
+    CHECK(sliceSizes == std::vector<size_t>{ 33, 33, 34 });
+
+    auto allCodesView = Common::AllCodesView();
+    std::vector<Common::Code> allCodes(allCodesView.begin(), allCodesView.end());
+    std::vector<Common::Code> guesses;
+    for ( int threadCount : { 1, 4 } )
+    {
+        ThreadCountGuard threadCountGuard( threadCount );
+        auto strategy = std::make_shared<MiniMaxStrategy>();
+        strategy->SetTranspositionTable(nullptr);
+        CodeBreaker codeBreaker( strategy );
+        codeBreaker.SetAllCodes(allCodes);
+        Common::Code secret( 3456 );
+        for ( int i = 0; i < 3; i++ )
+        {
+            guesses.push_back(codeBreaker.Guess());
+            codeBreaker.SetResult(guesses.back().Compare(secret));
+        }
+    }
+    CHECK(std::equal(guesses.begin(), guesses.begin() + 3, guesses.begin() + 3));
+}
+
+TEST_CASE("Testing branch and bound MiniMax selects the same guesses") {
+    auto allCodesView = Common::AllCodesView();
+    std::vector<Common::Code> allCodes(allCodesView.begin(), allCodesView.end());
+    auto prunedStrategy = std::make_shared<MiniMaxStrategy>(true);
+    auto exhaustiveStrategy = std::make_shared<MiniMaxStrategy>(false);
+    prunedStrategy->SetTranspositionTable(nullptr);
+    exhaustiveStrategy->SetTranspositionTable(nullptr);
+    prunedStrategy->SetIncremental(false);
+    exhaustiveStrategy->SetIncremental(false);
+    CHECK(CompareGames(prunedStrategy, exhaustiveStrategy, allCodes, 97).mismatchCount == 0);
+    CHECK(prunedStrategy->GetStatistics().moveCount == exhaustiveStrategy->GetStatistics().moveCount);
+    CHECK(prunedStrategy->GetStatistics().scoredCandidateCount < exhaustiveStrategy->GetStatistics().scoredCandidateCount);
+}
+
+TEST_CASE("Testing incremental partition counts select the same guesses") {
+    auto allCodesView = Common::AllCodesView();
+    std::vector<Common::Code> allCodes(allCodesView.begin(), allCodesView.end());
+    auto incrementalStrategy = std::make_shared<MiniMaxStrategy>();
+    auto scoringStrategy = std::make_shared<MiniMaxStrategy>();
+    incrementalStrategy->SetTranspositionTable(nullptr);
+    scoringStrategy->SetTranspositionTable(nullptr);
+    scoringStrategy->SetIncremental(false);
+    CHECK(CompareGames(incrementalStrategy, scoringStrategy, allCodes, 43).mismatchCount == 0);
+    CHECK(incrementalStrategy->GetStatistics().moveCount == scoringStrategy->GetStatistics().moveCount);
+}
+
+TEST_CASE("Testing symmetry reduction of the guess pool") {
+    auto allCodesView = Common::AllCodesView();
+    std::vector<Common::Code> allCodes(allCodesView.begin(), allCodesView.end());
+    auto openings = Symmetry({}).Representatives(allCodes);
+    CHECK(openings == std::vector<Common::Code>{ Common::Code(1111), Common::Code(1112), Common::Code(1122), Common::Code(1123), Common::Code(1234) });
+
+    Symmetry symmetry( { Common::Code(1122) } );
+    CHECK(symmetry.IsRepresentative(Common::Code(1123)));
+    CHECK_FALSE(symmetry.IsRepresentative(Common::Code(1124)));
+    CHECK_FALSE(symmetry.IsRepresentative(Common::Code(1222)));
+    CHECK(symmetry.IsRepresentative(Common::Code(2211)));
+    CHECK(symmetry.Representatives(allCodes).size() < allCodes.size() / 10);
+    CHECK(Symmetry( { Common::Code(1234), Common::Code(1356) } ).IsTrivial());
+
+    // Separate strategies without a transposition table, so the full pool is searched and not answered by the reduced one
+    auto reducedStrategy = std::make_shared<MiniMaxStrategy>();
+    auto fullStrategy = std::make_shared<MiniMaxStrategy>();
+    for ( const auto& strategy : { reducedStrategy, fullStrategy } )
+    {
+        strategy->SetTranspositionTable(nullptr);
+        strategy->SetIncremental(false);
+    }
+    auto games = CompareGames(reducedStrategy, fullStrategy, allCodes, 61, []( CodeBreaker&, CodeBreaker& fullCodeBreaker ){
+        fullCodeBreaker.SetSymmetryReduction(false);
+    });
+    CHECK(games.mismatchCount == 0);
+}
+
+TEST_CASE("Testing opening book") {
+    auto book = OpeningBook::Build(std::make_shared<MiniMaxStrategy>(), Common::GameMode::MiniMax);
+    const std::string path = "minimax_unit_test.book";
+    book->Save(path);
+    auto loadedBook = OpeningBook::Load(path);
+    std::remove(path.c_str());
+    CHECK(loadedBook->NodeCount() == book->NodeCount());
+    CHECK(loadedBook->GetMode() == Common::GameMode::MiniMax);
+    CHECK(loadedBook->Find({}, {}) == Common::Code(1122));
+
+    auto allCodesView = Common::AllCodesView();
+    std::vector<Common::Code> allCodes(allCodesView.begin(), allCodesView.end());
+    auto bookStrategy = std::make_shared<BookStrategy>(loadedBook, std::make_shared<MiniMaxStrategy>());
+    int maximumGuessCount = 0;
+    int mismatchCount = 0;
+    for ( const auto& secret : allCodes )
+    {
+        CodeBreaker codeBreaker( bookStrategy );
+        codeBreaker.SetAllCodes(allCodes);
+        for ( int i = 0; i < MaximumRoundCount; i++ )
+        {
+            auto feedback = codeBreaker.Guess().Compare(secret).ToFeedbackId();
+            codeBreaker.SetResult(feedback);
+            if ( feedback == Common::WinningFeedback )
+            {
+                maximumGuessCount = std::max(maximumGuessCount, i + 1);
+                break;
+            }
+        }
+    }
+    CHECK(bookStrategy->GetFallbackCount() == 0);
+    CHECK(maximumGuessCount == 5);
+
+    CodeBreaker codeBreaker( bookStrategy );
+    codeBreaker.SetAllCodes(allCodes);
+    CodeBreaker liveCodeBreaker( std::make_shared<MiniMaxStrategy>() );
+    liveCodeBreaker.SetAllCodes(allCodes);
+    for ( auto guess : { Common::Code(1234), Common::Code(5566) } )
+    {
+        codeBreaker.SetStrategy(std::make_shared<UnitTestStrategy>(guess));
+        codeBreaker.Guess();
+        codeBreaker.SetResult(guess.Compare(Common::Code(2365)));
+        liveCodeBreaker.SetStrategy(std::make_shared<UnitTestStrategy>(guess));
+        liveCodeBreaker.Guess();
+        liveCodeBreaker.SetResult(guess.Compare(Common::Code(2365)));
+    }
+    codeBreaker.SetStrategy(bookStrategy);
+    liveCodeBreaker.SetStrategy(std::make_shared<MiniMaxStrategy>());
+    mismatchCount += !(codeBreaker.Guess() == liveCodeBreaker.Guess());
+    CHECK(bookStrategy->GetFallbackCount() == 1);
+    CHECK(mismatchCount == 0);
+}
+
+TEST_CASE("Testing transposition table") {
+    TranspositionTable table( TranspositionTable::ShardCount * 2 );
+    auto allCodes = CandidateSet::All();
+    auto key = TranspositionTable::MakeKey(1, LengthOfSecret, ColorCount, allCodes.Words());
+    CHECK_FALSE(table.Find(key));
+    table.Insert(key, 42);
+    CHECK(table.Find(key) == 42u);
+    CHECK_FALSE(key == TranspositionTable::MakeKey(2, LengthOfSecret, ColorCount, allCodes.Words()));
+    CHECK_FALSE(key == TranspositionTable::MakeKey(1, LengthOfSecret, ColorCount, allCodes.Words(), allCodes.Words()));
+    allCodes.Erase(7);
+    CHECK_FALSE(key == TranspositionTable::MakeKey(1, LengthOfSecret, ColorCount, allCodes.Words()));
+
+    for ( uint32_t strategyId = 0; strategyId < 1000; strategyId++ )
+        table.Insert(TranspositionTable::MakeKey(strategyId + 2, LengthOfSecret, ColorCount, allCodes.Words()), strategyId);
+    CHECK(table.GetHitCount() == 1);
+    CHECK(table.GetMissCount() == 1);
+    int evictedCount = 0;
+    for ( uint32_t strategyId = 0; strategyId < 1000; strategyId++ )
+        evictedCount += !table.Find(TranspositionTable::MakeKey(strategyId + 2, LengthOfSecret, ColorCount, allCodes.Words()));
+    CHECK(evictedCount == 1000 - static_cast<int>(TranspositionTable::ShardCount) * 2);
+
+    TranspositionTable gameTable;
+
+    auto allCodesView = Common::AllCodesView();
+    std::vector<Common::Code> codes(allCodesView.begin(), allCodesView.end());
+    auto cachedStrategy = std::make_shared<MiniMaxStrategy>();
+    auto liveStrategy = std::make_shared<MiniMaxStrategy>();
+    cachedStrategy->SetTranspositionTable(&gameTable);
+    liveStrategy->SetTranspositionTable(nullptr);
+    for ( int round = 0; round < 2; round++ )
+        CHECK(CompareGames(cachedStrategy, liveStrategy, codes, 53).mismatchCount == 0);
+    CHECK(gameTable.GetHitCount() > gameTable.GetMissCount());
+}
+
 TEST_CASE("Testing game with SwaszekStrategy strategy") {
     Game game( Common::GameMode::Swaszek );
     int winRound = game.StartTheGame();
     CHECK(winRound != -1);
 }
 
+TEST_CASE("Testing games with other sizes") {
+    using Config = Common::GameConfig<5, 8>;
+    Common::BasicCode<Config> code( {1,2,3,4,5} );
+    auto result = code.Compare(Common::BasicCode<Config>( {5,2,8,4,1} ));
+    CHECK(result.blackCount == 2);
+    CHECK(result.whiteCount == 2);
+    CHECK(Common::GetCodeCount<Config>() == 32768);
+    CHECK(Common::GetFeedbackCount<Config>() == 20);
+
+    BasicGame<Config> game( Common::GameMode::Swaszek );
+    game.SetVerbose(false);
+    CHECK(game.StartTheGame() != -1);
+
+    auto engine = Engines::SelectEngine(3, 4);
+    CHECK_FALSE(engine.isSpecialized);
+    CHECK(Common::GetCodeCount<Common::RuntimeConfig>() == 64);
+    CHECK(engine.playGame(Common::GameMode::MiniMax, false, std::chrono::milliseconds::zero()) != -1);
+    CHECK(Engines::SelectEngine(6, 9).isSpecialized);
+    CHECK_THROWS_AS(Engines::SelectEngine(16, 6), std::invalid_argument);
+}
+
 TEST_CASE("Testing the performace of game with Swaszek strategy") {
     int totalWinTurnCount = 0;
     std::cout << "Checking average win turn for swaszek strategy" << std::endl;
@@ -122,4 +589,408 @@ TEST_CASE("Testing the performace of game with MiniMax strategy") {
 
     double average = totalWinTurnCount / 100.0;
     std::cout << "Average win round with MiniMax strategy was: " << average << std::endl;
-}
\ No newline at end of file
+}
+TEST_CASE("Testing partition strategies against every secret") {
+    auto allCodesView = Common::AllCodesView();
+    std::vector<Common::Code> allCodes(allCodesView.begin(), allCodesView.end());
+    auto playAll = [&allCodes]( const std::string& name, std::shared_ptr<IStrategy> strategy ) {
+        int totalWinTurnCount = 0;
+        int maximumWinTurnCount = 0;
+        int lostCount = 0;
+        for ( const auto& secret : allCodes )
+        {
+            CodeBreaker codeBreaker( strategy );
+            codeBreaker.SetAllCodes(allCodes);
+            int winTurnCount = 0;
+            for ( int i = 0; i < MaximumRoundCount && winTurnCount == 0; i++ )
+            {
+                auto feedback = codeBreaker.Guess().Compare(secret).ToFeedbackId();
+                codeBreaker.SetResult(feedback);
+                if ( feedback == Common::WinningFeedback )
+                    winTurnCount = i + 1;
+            }
+            lostCount += winTurnCount == 0;
+            totalWinTurnCount += winTurnCount;
+            maximumWinTurnCount = std::max(maximumWinTurnCount, winTurnCount);
+        }
+        CHECK(lostCount == 0);
+        double average = totalWinTurnCount / static_cast<double>(allCodes.size());
+        std::cout << "Average win round with " << name << " strategy was: " << average << ", at most " << maximumWinTurnCount << std::endl;
+        return average;
+    };
+
+    double worstCaseAverage = playAll("worst case policy", std::make_shared<BasicPartitionStrategy<Common::ClassicConfig, PartitionPolicy::WorstCase>>());
+    auto miniMaxStrategy = std::make_shared<MiniMaxStrategy>();
+    miniMaxStrategy->SetTranspositionTable(nullptr);
+    CHECK(worstCaseAverage == playAll("MiniMax", miniMaxStrategy));
+    CHECK(playAll("Entropy", std::make_shared<EntropyStrategy>()) < worstCaseAverage);
+    CHECK(playAll("ExpectedSize", std::make_shared<ExpectedSizeStrategy>()) < worstCaseAverage);
+    CHECK(playAll("MostParts", std::make_shared<MostPartsStrategy>()) < worstCaseAverage);
+}
+
+TEST_CASE("Testing optimal strategy on small games") {
+    using Config = Common::GameConfig<3, 3>;
+    using Code = Common::BasicCode<Config>;
+    using Set = BasicCandidateSet<Config>;
+    auto allCodesView = Common::AllCodesView<Config>();
+    std::vector<Code> allCodes(allCodesView.begin(), allCodesView.end());
+
+    // Exhaustive search over every guess without any pruning
+    std::map<std::vector<uint64_t>, int> exhaustiveCosts;
+    std::function<int( const Set& )> exhaustiveCost = [&]( const Set& codes ) {
+        if ( codes.Count() == 1 )
+            return 1;
+        std::vector<uint64_t> key(codes.Words().begin(), codes.Words().end());
+        if ( auto itr = exhaustiveCosts.find(key); itr != exhaustiveCosts.end() )
+            return itr->second;
+        int best = std::numeric_limits<int>::max();
+        for ( const auto& guess : allCodes )
+        {
+            std::vector<Set> partitions(Common::GetFeedbackCount<Config>());
+            codes.ForEach([&]( size_t index ){
+                partitions[guess.Compare(Code::FromIndex(index)).template ToFeedbackId<Config>()].Insert(index);
+            });
+            int cost = static_cast<int>(codes.Count());
+            bool isSplit = true;
+            for ( int feedback = 0; feedback < Common::GetFeedbackCount<Config>(); feedback++ )
+            {
+                if ( feedback == Common::GetWinningFeedback<Config>() || partitions[feedback].Empty() )
+                    continue;
+                isSplit = isSplit && partitions[feedback].Count() < codes.Count();
+                if ( isSplit )
+                    cost += exhaustiveCost(partitions[feedback]);
+            }
+            if ( isSplit )
+                best = std::min(best, cost);
+        }
+        exhaustiveCosts[key] = best;
+        return best;
+    };
+
+    TranspositionTable table;
+    auto strategy = std::make_shared<BasicOptimalStrategy<Config>>();
+    strategy->SetTranspositionTable(&table);
+    const uint32_t optimalCost = strategy->Cost(Set(allCodes), {});
+    CHECK(optimalCost == static_cast<uint32_t>(exhaustiveCost(Set(allCodes))));
+    CHECK(strategy->GetStatistics().nodeCount > 0);
+
+    int totalWinTurnCount = 0;
+    std::vector<Code> firstGuesses;
+    for ( int threadCount : { 1, 3 } )
+    {
+        ThreadCountGuard threadCountGuard( threadCount );
+        TranspositionTable gameTable;
+        auto gameStrategy = std::make_shared<BasicOptimalStrategy<Config>>();
+        gameStrategy->SetTranspositionTable(&gameTable);
+        totalWinTurnCount = 0;
+        for ( const auto& secret : allCodes )
+        {
+            BasicCodeBreaker<Config> codeBreaker( gameStrategy );
+            codeBreaker.SetAllCodes(allCodes);
+            for ( int i = 0; i < Config::MaximumRoundCount(); i++ )
+            {
+                auto guess = codeBreaker.Guess();
+                if ( i == 0 && secret == allCodes.front() )
+                    firstGuesses.push_back(guess);
+                auto feedback = guess.Compare(secret).template ToFeedbackId<Config>();
+                codeBreaker.SetResult(feedback);
+                if ( feedback == Common::GetWinningFeedback<Config>() )
+                {
+                    totalWinTurnCount += i + 1;
+                    break;
+                }
+            }
+        }
+        CHECK(totalWinTurnCount == static_cast<int>(optimalCost));
+    }
+    CHECK(firstGuesses[0] == firstGuesses[1]);
+}
+
+TEST_CASE("Testing genetic strategy") {
+    auto allCodesView = Common::AllCodesView<Common::ClassicConfig>();
+    std::vector<Common::Code> codes(allCodesView.begin(), allCodesView.end());
+    auto strategy = std::make_shared<GeneticStrategy>();
+    std::vector<std::vector<Common::Code>> gamesOfThreadCounts;
+    for ( int threadCount : { 1, 3 } )
+    {
+        ThreadCountGuard threadCountGuard( threadCount );
+        std::vector<Common::Code> guesses;
+        bool isConsistent = true;
+        int totalWinTurnCount = 0;
+        int gameCount = 0;
+        for ( size_t secretIndex = 0; secretIndex < codes.size(); secretIndex += 50, gameCount++ )
+        {
+            const auto& secret = codes[secretIndex];
+            CodeBreaker codeBreaker( strategy );
+            codeBreaker.StartWithoutEnumeration();
+            CHECK_FALSE(codeBreaker.GetContext().IsEnumerated());
+            for ( int i = 0; i < MaximumRoundCount; i++ )
+            {
+                auto guess = codeBreaker.Guess();
+                guesses.push_back(guess);
+                const auto& context = codeBreaker.GetContext();
+                for ( size_t j = 0; j < context.PastFeedbacks().size(); j++ )
+                    isConsistent = isConsistent && guess.Compare(context.PastGuesses()[j]).ToFeedbackId() == context.PastFeedbacks()[j];
+                auto feedback = guess.Compare(secret).ToFeedbackId();
+                CHECK(codeBreaker.SetResult(feedback) == -1);
+                if ( feedback == Common::WinningFeedback )
+                {
+                    totalWinTurnCount += i + 1;
+                    break;
+                }
+                CHECK(i + 1 < MaximumRoundCount);
+            }
+        }
+        CHECK(isConsistent);
+        std::cout << "Average win round with Genetic strategy was: " << totalWinTurnCount / static_cast<double>(gameCount) << std::endl;
+        gamesOfThreadCounts.push_back(guesses);
+    }
+    CHECK(gamesOfThreadCounts[0] == gamesOfThreadCounts[1]);
+    CHECK(strategy->GetStatistics().searchCount > 0);
+    CHECK(strategy->GetStatistics().EvaluationsPerSecond() > 0);
+
+    // 8 pegs and 12 colors have 430 million codes, none of them is listed
+    using Config = Common::GameConfig<8, 12>;
+    auto bigStrategy = std::make_shared<BasicGeneticStrategy<Config>>();
+    for ( const auto& secret : { Common::BasicCode<Config>( {3,1,4,1,5,9,2,6} ), Common::BasicCode<Config>( {12,11,10,9,8,7,6,5} ) } )
+    {
+        BasicCodeBreaker<Config> codeBreaker( bigStrategy );
+        codeBreaker.StartWithoutEnumeration();
+        bool isWon = false;
+        for ( int i = 0; i < Config::MaximumRoundCount() && !isWon; i++ )
+        {
+            auto feedback = codeBreaker.Guess().Compare(secret).template ToFeedbackId<Config>();
+            codeBreaker.SetResult(feedback);
+            isWon = feedback == Common::GetWinningFeedback<Config>();
+        }
+        CHECK(isWon);
+        CHECK(bigStrategy->GetStatistics().eligibleCount > 0);
+    }
+}
+
+TEST_CASE("Testing sampled MiniMax strategy") {
+    // When every candidate fits in the sample and every guess is scored it plays exactly like MiniMax
+    auto allCodesView = Common::AllCodesView<Common::ClassicConfig>();
+    std::vector<Common::Code> codes(allCodesView.begin(), allCodesView.end());
+    SampledMiniMaxStrategy::Settings settings;
+    settings.timeBudget = std::chrono::milliseconds::max();
+    auto sampledStrategy = std::make_shared<SampledMiniMaxStrategy>(settings);
+    auto miniMaxStrategy = std::make_shared<MiniMaxStrategy>();
+    CHECK(CompareGames(sampledStrategy, miniMaxStrategy, codes, 7).mismatchCount == 0);
+    CHECK(sampledStrategy->GetStatistics().candidateSampleSize < sampledStrategy->CandidateSampleSize());
+
+    // Samples of a 5 pegs 8 colors game, guesses do not depend on the number of threads
+    using Config = Common::GameConfig<5, 8>;
+    using Code = Common::BasicCode<Config>;
+    auto bigCodesView = Common::AllCodesView<Config>();
+    std::vector<Code> bigCodes(bigCodesView.begin(), bigCodesView.end());
+    BasicSampledMiniMaxStrategy<Config>::Settings bigSettings;
+    bigSettings.tolerance = 0.1;
+    bigSettings.guessSampleSize = 100;
+    bigSettings.timeBudget = std::chrono::milliseconds::max();
+    std::vector<std::vector<Code>> gamesOfThreadCounts;
+    for ( int threadCount : { 1, 3 } )
+    {
+        ThreadCountGuard threadCountGuard( threadCount );
+        auto strategy = std::make_shared<BasicSampledMiniMaxStrategy<Config>>(bigSettings);
+        CHECK(strategy->CandidateSampleSize() == 185);
+        std::vector<Code> guesses;
+        for ( const auto& secret : { Code( {1,2,3,4,5} ), Code( {8,8,1,7,3} ) } )
+        {
+            BasicCodeBreaker<Config> codeBreaker( strategy );
+            codeBreaker.SetAllCodes(bigCodes);
+            bool isWon = false;
+            for ( int i = 0; i < Config::MaximumRoundCount() && !isWon; i++ )
+            {
+                guesses.push_back(codeBreaker.Guess());
+                auto feedback = guesses.back().Compare(secret).template ToFeedbackId<Config>();
+                codeBreaker.SetResult(feedback);
+                isWon = feedback == Common::GetWinningFeedback<Config>();
+            }
+            CHECK(isWon);
+        }
+        CHECK(strategy->GetStatistics().scoredGuessCount <= 100 * strategy->GetStatistics().moveCount);
+        gamesOfThreadCounts.push_back(guesses);
+    }
+    CHECK(gamesOfThreadCounts[0] == gamesOfThreadCounts[1]);
+}
+
+TEST_CASE("Testing consistent code finder") {
+    using Common::Code;
+    CHECK(ConsistentCodeFinder({}, {}).First() == Code(1111));
+    std::vector<Code> guesses{ Code(1122), Code(1111) };
+    CHECK_FALSE(ConsistentCodeFinder(guesses, { Common::Result{ 0, 0 }.ToFeedbackId(), Common::WinningFeedback }).First().has_value());
+
+    // Swaszek plays the same guesses from the history alone as from the enumerated candidates
+    auto allCodesView = Common::AllCodesView<Common::ClassicConfig>();
+    std::vector<Code> codes(allCodesView.begin(), allCodesView.end());
+    auto strategy = std::make_shared<SwaszekStrategy>();
+    bool isRandomConsistent = true;
+    std::mt19937_64 random(7);
+    auto games = CompareGames(strategy, strategy, codes, 1, []( CodeBreaker&, CodeBreaker& codeBreaker ){
+        codeBreaker.StartWithoutEnumeration();
+    }, [&]( const CodeBreaker& enumeratedCodeBreaker, const CodeBreaker& codeBreaker ){
+        const auto& context = codeBreaker.GetContext();
+        auto randomCode = ConsistentCodeFinder(context.PastGuesses(), context.PastFeedbacks()).Random(random);
+        isRandomConsistent = isRandomConsistent && randomCode && enumeratedCodeBreaker.GetProbableCodes().Contains(randomCode->GetIndex());
+    });
+    CHECK(games.mismatchCount == 0);
+    CHECK(isRandomConsistent);
+
+    // 10 pegs and 6 colors have 60 million codes, none of them is listed
+    using Config = Common::GameConfig<10, 6, 20>;
+    BasicCodeBreaker<Config> codeBreaker( std::make_shared<BasicSwaszekStrategy<Config>>() );
+    codeBreaker.StartWithoutEnumeration();
+    const Common::BasicCode<Config> secret( {6,1,5,2,4,3,3,6,1,2} );
+    bool isWon = false;
+    for ( int i = 0; i < Config::MaximumRoundCount() && !isWon; i++ )
+    {
+        auto feedback = codeBreaker.Guess().Compare(secret).template ToFeedbackId<Config>();
+        codeBreaker.SetResult(feedback);
+        isWon = feedback == Common::GetWinningFeedback<Config>();
+    }
+    CHECK(isWon);
+}
+
+TEST_CASE("Testing deadline strategy") {
+    using Common::Code;
+    SearchLimit unlimited;
+    CHECK_FALSE(unlimited.ShouldStop());
+    CHECK_FALSE(unlimited.IsCut());
+    unlimited.Cancel();
+    CHECK(unlimited.ShouldStop());
+    CHECK(unlimited.IsCut());
+
+    // Interrupted MiniMax scores only the first guess, which can still be the secret, and does not remember it
+    auto allCodesView = Common::AllCodesView<Common::ClassicConfig>();
+    std::vector<Code> codes(allCodesView.begin(), allCodesView.end());
+    TranspositionTable transpositionTable;
+    auto miniMaxStrategy = std::make_shared<MiniMaxStrategy>();
+    miniMaxStrategy->SetTranspositionTable(&transpositionTable);
+    CodeBreaker codeBreaker( miniMaxStrategy );
+    codeBreaker.SetAllCodes(codes);
+    codeBreaker.Guess();
+    codeBreaker.SetResult(Common::Result{ 1, 1 }.ToFeedbackId());
+    SearchLimit cancelledLimit;
+    cancelledLimit.Cancel();
+    miniMaxStrategy->SetSearchLimit(&cancelledLimit);
+    auto evaluatedGuessCount = miniMaxStrategy->GetStatistics().evaluatedGuessCount;
+    auto cutGuess = codeBreaker.Guess();
+    CHECK(miniMaxStrategy->GetStatistics().evaluatedGuessCount == evaluatedGuessCount + 1);
+    CHECK(codeBreaker.GetProbableCodes().Contains(cutGuess.GetIndex()));
+    miniMaxStrategy->SetSearchLimit(nullptr);
+    auto fullGuess = codeBreaker.Guess();
+    CHECK(miniMaxStrategy->GetStatistics().evaluatedGuessCount > evaluatedGuessCount + 100);
+    CHECK(fullGuess != cutGuess);
+
+    // Without time a move plays the first candidate like Swaszek, with unlimited time it plays like MiniMax
+    auto playsLike = [&codes]( std::chrono::milliseconds moveBudget, std::shared_ptr<IStrategy> expectedStrategy ){
+        auto deadlineStrategy = std::make_shared<DeadlineStrategy>(std::make_shared<MiniMaxStrategy>(), moveBudget);
+        auto games = CompareGames(deadlineStrategy, expectedStrategy, codes, 11);
+        CHECK(games.mismatchCount == 0);
+        CHECK(games.lostCount == 0);
+        return deadlineStrategy->GetStatistics();
+    };
+    auto cutStatistics = playsLike(std::chrono::milliseconds::zero(), std::make_shared<SwaszekStrategy>());
+    CHECK(cutStatistics.moveCount > 0);
+    CHECK(cutStatistics.CutRate() == 1);
+    auto fullStatistics = playsLike(std::chrono::milliseconds::max(), std::make_shared<MiniMaxStrategy>());
+    CHECK(fullStatistics.cutMoveCount == 0);
+    CHECK(fullStatistics.lateMoveCount == 0);
+
+    // Lookahead and genetic strategies stop at the limit too, cut lookahead plays the greedy policy and genetic one generation
+    auto cutLookahead = std::make_shared<LookaheadStrategy>();
+    cutLookahead->SetSearchLimit(&cancelledLimit);
+    CHECK(CompareGames(cutLookahead, std::make_shared<ExpectedSizeStrategy>(), codes, 11).mismatchCount == 0);
+    CHECK(cutLookahead->GetStatistics().nodeCount == 0);
+    auto cutGenetic = std::make_shared<GeneticStrategy>();
+    cutGenetic->SetSearchLimit(&cancelledLimit);
+    CompareGames(cutGenetic, std::make_shared<SwaszekStrategy>(), codes, 101);
+    CHECK(cutGenetic->GetStatistics().searchCount > 0);
+    CHECK(cutGenetic->GetStatistics().generationCount == cutGenetic->GetStatistics().searchCount);
+}
+
+TEST_CASE("Testing portfolio strategy") {
+    using Common::Code;
+    auto allCodesView = Common::AllCodesView<Common::ClassicConfig>();
+    std::vector<Code> codes(allCodesView.begin(), allCodesView.end());
+    auto playGames = [&codes]( std::shared_ptr<PortfolioStrategy> strategy ){
+        std::vector<Code> guesses;
+        int totalWinTurnCount = 0;
+        int gameCount = 0;
+        bool isLogged = true;
+        for ( size_t secretIndex = 0; secretIndex < codes.size(); secretIndex += 13, gameCount++ )
+        {
+            CodeBreaker codeBreaker( strategy );
+            codeBreaker.SetAllCodes(codes);
+            for ( int i = 0; i < MaximumRoundCount; i++ )
+            {
+                guesses.push_back(codeBreaker.Guess());
+                isLogged = isLogged && strategy->GetRoundWinners().size() == static_cast<size_t>(i + 1);
+                auto feedback = guesses.back().Compare(codes[secretIndex]).ToFeedbackId();
+                codeBreaker.SetResult(feedback);
+                if ( feedback == Common::WinningFeedback )
+                {
+                    totalWinTurnCount += i + 1;
+                    break;
+                }
+            }
+        }
+        CHECK(isLogged);
+        CHECK(totalWinTurnCount / static_cast<double>(gameCount) < 4.6);
+        return guesses;
+    };
+
+    // Races are settled the same way with any number of threads, a member which can not be beaten cancels the later ones
+    std::vector<std::vector<Code>> gamesOfThreadCounts;
+    for ( int threadCount : { 1, 3 } )
+    {
+        ThreadCountGuard threadCountGuard( threadCount );
+        auto strategy = std::make_shared<PortfolioStrategy>(PortfolioStrategy::DefaultMembers());
+        gamesOfThreadCounts.push_back(playGames(strategy));
+        const auto& statistics = strategy->GetStatistics();
+        long long winCount = 0;
+        for ( auto memberWinCount : statistics.winCounts )
+            winCount += memberWinCount;
+        CHECK(winCount == static_cast<long long>(gamesOfThreadCounts.back().size()));
+        CHECK(statistics.cancelledMoveCount > 0);
+        CHECK(statistics.cutMoveCount == 0);
+        CHECK(statistics.winCounts[0] > 0);
+    }
+    CHECK(gamesOfThreadCounts[0] == gamesOfThreadCounts[1]);
+
+    // Without time every member returns the first guess it scores, the race is still won by a guess which can be the secret
+    auto cutStrategy = std::make_shared<PortfolioStrategy>(PortfolioStrategy::DefaultMembers(), std::chrono::milliseconds::zero());
+    playGames(cutStrategy);
+    CHECK(cutStrategy->GetStatistics().cutMoveCount > 0);
+}
+
+TEST_CASE("Testing lookahead strategy") {
+    using Common::Code;
+    auto allCodesView = Common::AllCodesView<Common::ClassicConfig>();
+    std::vector<Code> codes(allCodesView.begin(), allCodesView.end());
+
+    // Width of one is the greedy policy
+    LookaheadStrategy::Settings greedySettings;
+    greedySettings.width = 1;
+    greedySettings.depth = 1;
+    auto greedyGames = CompareGames(std::make_shared<LookaheadStrategy>(greedySettings), std::make_shared<ExpectedSizeStrategy>(), codes, 1);
+    CHECK(greedyGames.mismatchCount == 0);
+    CHECK(greedyGames.maximumWinTurnCount == 6);
+
+    // Two-ply over all secrets beats the greedy policy and gets close to the optimum of 5625 guesses
+    auto strategy = std::make_shared<LookaheadStrategy>();
+    auto games = CompareGames(strategy, std::make_shared<ExpectedSizeStrategy>(), codes, 1);
+    CHECK(games.mismatchCount > 0);
+    CHECK(games.lostCount == 0);
+    std::cout << "Average win round with two-ply lookahead strategy was: " << games.totalWinTurnCount / static_cast<double>(codes.size())
+              << ", at most " << games.maximumWinTurnCount << std::endl;
+    CHECK(games.totalWinTurnCount < greedyGames.totalWinTurnCount);
+    CHECK(games.totalWinTurnCount < 5650);
+    CHECK(games.maximumWinTurnCount <= 6);
+    CHECK(strategy->GetStatistics().memoHitCount > 0);
+
+    // Guesses do not depend on the number of threads
+    ThreadCountGuard threadCountGuard( 3 );
+    CHECK(CompareGames(std::make_shared<LookaheadStrategy>(), strategy, codes, 17).mismatchCount == 0);
+}
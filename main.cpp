@@ -1,8 +1,13 @@
 #define DOCTEST_CONFIG_IMPLEMENT
 
-#include "Game.h"
+#include "Engines.h"
+#include "ThreadPool.h"
 #include "UnitTests/UnitTests.h"
+#include "Benchmarks/Benchmarks.h"
 
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <iostream>
 
 //! Helper Function for Program Option
@@ -15,13 +20,42 @@ bool cmdOptionExists(char** begin, char** end, const std::string& option)
     return std::find(begin, end, option) != end;
 }
 
+//! Helper Function for Program Option
+/*!
+    Returns the integer after the option, for "-p 5" returns 5. If option does not exist or has no value returns defaultValue.
+*/
+int getCmdOption(char** begin, char** end, const std::string& option, int defaultValue)
+{
+    char** itr = std::find(begin, end, option);
+    if (itr != end && ++itr != end)
+        return std::atoi(*itr);
+    return defaultValue;
+}
+
+//! Helper Function for Program Option
+/*!
+    Returns the text after the option, for "-l minimax.book" returns "minimax.book". If option does not exist returns empty string.
+*/
+std::string getCmdOptionText(char** begin, char** end, const std::string& option)
+{
+    char** itr = std::find(begin, end, option);
+    if (itr != end && ++itr != end)
+        return *itr;
+    return "";
+}
+
 //! main function
 /*!
     I decided to keep Unit test and application within same program. I used "doctest" for unit test framework.
-    If user uses "-t" as option than unit tests will trigger.
+    If user uses "-t" as option than unit tests will trigger. With "-b" option benchmarks will run.
+    Size of the game can be selected with "-p <pegs>" and "-c <colors>", classic game(4 pegs 6 colors) is the default.
+    Number of threads strategies use can be set with "-j <threads>", default is the number of hardware threads.
+    "-d <milliseconds>" gives the computer strategy a deadline for every guess, it plays the best guess found when the time is up.
+    For the classic game "-w <file>" writes the opening book of the selected computer strategy and "-l <file>" plays with a book.
 */
 int main( int argc, char *argv[] )
 {
+    ThreadPool::SetThreadCount(getCmdOption(argv, argv + argc, "-j", ThreadPool::DefaultThreadCount()));
     if (cmdOptionExists(argv, argv + argc, "-t"))
     {
         doctest::Context context;
@@ -29,23 +63,118 @@ int main( int argc, char *argv[] )
         std::cout << res;
         return 0;
     }
+    else if (cmdOptionExists(argv, argv + argc, "-b"))
+    {
+        Benchmarks::RunAll();
+        return 0;
+    }
     else
     {
         std::cout << "Codebreaker please select your strategy by pressing: " << std::endl
                   << "(1)-Play as Human" << std::endl
                   << "(2)-Minimax algorithm developed by Donald Knuth will be play by computer " << std::endl
-                  << "(3)-Swaszek algorithm which requires no bookkeeping and still wins" << std::endl;
+                  << "(3)-Swaszek algorithm which requires no bookkeeping and still wins" << std::endl
+                  << "(4)-Entropy algorithm which guesses the code whose feedback gives most information" << std::endl
+                  << "(5)-Expected size algorithm by Irving which guesses the code that leaves least codes on average" << std::endl
+                  << "(6)-Most parts algorithm by Kooi which guesses the code that can get most different feedbacks" << std::endl
+                  << "(7)-Optimal algorithm which searches the whole game tree for the smallest average, first guess takes a while" << std::endl
+                  << "(8)-Genetic algorithm by Berghman et al. which evolves codes that can be the secret, it plays games too big to list" << std::endl
+                  << "(9)-Portfolio which races MiniMax, Entropy, sampled MiniMax and Swaszek algorithms and plays the best guess" << std::endl
+                  << "(10)-Lookahead algorithm which looks two moves ahead from the best guesses of the expected size algorithm" << std::endl;
 
         int userInput;
         std::cin >> userInput;
-        if ( userInput < 1 || userInput > 3 )
+        if ( userInput < 1 || userInput > static_cast<int>(Common::GameModeCount) )
         {
             std::cout << "Invalid input program will be terminated" << std::endl;
+            return 0;
+        }
+
+        int lengthOfSecret = getCmdOption(argv, argv + argc, "-p", LengthOfSecret);
+        int colorCount = getCmdOption(argv, argv + argc, "-c", ColorCount);
+        if ( lengthOfSecret < 1 || lengthOfSecret > Common::RuntimeConfig::MaxLength || colorCount < 1 || colorCount > Common::RuntimeConfig::MaxColors )
+        {
+            std::cout << "Games can have 1 to " << Common::RuntimeConfig::MaxLength << " pegs and 1 to " << Common::RuntimeConfig::MaxColors
+                      << " colors program will be terminated" << std::endl;
+            return 0;
+        }
+        if ( (colorCount > 9 || lengthOfSecret > 9) && userInput == 1 )
+        {
+            std::cout << "Human players can only enter up to 9 pegs and 9 colors program will be terminated" << std::endl;
+            return 0;
         }
 
         Common::GameMode gameMode = static_cast<Common::GameMode>(userInput-1);
-        Game game(gameMode);
-        game.StartTheGame();
+        if ( std::pow(colorCount, lengthOfSecret) > static_cast<double>(GameLimits::MaximumCodeCount(gameMode)) )
+        {
+            std::cout << "This algorithm can play games with up to " << GameLimits::MaximumCodeCount(gameMode)
+                      << " codes, Swaszek and genetic algorithms can play any size" << std::endl;
+            return 0;
+        }
+        const int moveBudget = getCmdOption(argv, argv + argc, "-d", 0);
+        if ( moveBudget > 0 && gameMode == Common::GameMode::Optimal )
+        {
+            std::cout << "Optimal algorithm can not be interrupted, it can not be played with a deadline" << std::endl;
+            return 0;
+        }
+        std::string writtenBookPath = getCmdOptionText(argv, argv + argc, "-w");
+        std::string loadedBookPath = getCmdOptionText(argv, argv + argc, "-l");
+        if ( !writtenBookPath.empty() || !loadedBookPath.empty() )
+        {
+            if ( lengthOfSecret != LengthOfSecret || colorCount != ColorCount || gameMode == Common::GameMode::Human )
+            {
+                std::cout << "Opening books are only available for computer strategies of the classic game" << std::endl;
+                return 0;
+            }
+            if ( !writtenBookPath.empty() && (gameMode == Common::GameMode::Genetic || gameMode == Common::GameMode::Portfolio) )
+            {
+                std::cout << "Opening books can only be written for strategies whose guesses do not depend on time or random numbers"
+                          << std::endl;
+                return 0;
+            }
+            try
+            {
+                if ( !writtenBookPath.empty() )
+                {
+                    std::shared_ptr<IStrategy> strategy = std::make_shared<SwaszekStrategy>();
+                    if ( gameMode == Common::GameMode::MiniMax )
+                        strategy = std::make_shared<MiniMaxStrategy>();
+                    else if ( gameMode == Common::GameMode::Entropy )
+                        strategy = std::make_shared<EntropyStrategy>();
+                    else if ( gameMode == Common::GameMode::ExpectedSize )
+                        strategy = std::make_shared<ExpectedSizeStrategy>();
+                    else if ( gameMode == Common::GameMode::MostParts )
+                        strategy = std::make_shared<MostPartsStrategy>();
+                    else if ( gameMode == Common::GameMode::Optimal )
+                        strategy = std::make_shared<OptimalStrategy>();
+                    else if ( gameMode == Common::GameMode::Lookahead )
+                        strategy = std::make_shared<LookaheadStrategy>();
+                    auto start = std::chrono::steady_clock::now();
+                    auto book = OpeningBook::Build(strategy, gameMode);
+                    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                    book->Save(writtenBookPath);
+                    std::cout << "Opening book with " << book->NodeCount() << " guesses is written to " << writtenBookPath << std::endl;
+                    if ( auto optimalStrategy = std::dynamic_pointer_cast<OptimalStrategy>(strategy) )
+                        std::cout << "Optimal search visited " << optimalStrategy->GetStatistics().nodeCount << " nodes, "
+                                  << optimalStrategy->GetStatistics().nodeCount / elapsed.count() << " nodes/second" << std::endl;
+                    return 0;
+                }
+                auto book = OpeningBook::Load(loadedBookPath);
+                if ( book->GetMode() != gameMode )
+                {
+                    std::cout << "Opening book was written for another strategy" << std::endl;
+                    return 0;
+                }
+                OpeningBook::Install(book);
+            }
+            catch ( const std::exception& exception )
+            {
+                std::cout << exception.what() << std::endl;
+                return 0;
+            }
+        }
+        Engine engine = Engines::SelectEngine(lengthOfSecret, colorCount);
+        engine.playGame(gameMode, true, std::chrono::milliseconds(moveBudget));
     }
 
     return 0;